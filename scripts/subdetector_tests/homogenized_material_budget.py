@@ -0,0 +1,106 @@
+# SPDX-License-Identifier: LGPL-3.0-or-later
+# Copyright (C) 2026 ePIC Collaboration
+'''
+    A script to compare the material budget of a calorimeter in full and homogenized mode
+
+    It runs the epic_MaterialScan plugin on the detector as given (mode="full") and on a copy of
+    the compact files with mode="homogenized" for that detector, and compares the radiation and
+    nuclear interaction lengths crossed in the detector per ray and over the whole scan.
+    Rays that leave the detector through a side may cross part of a layer, which the homogenized
+    layer spreads over its whole thickness; a small fraction of such rays is allowed to differ.
+    use case:
+    python scripts/subdetector_tests/homogenized_material_budget.py \
+        -c $DETECTOR_PATH/epic_lfhcal_with_insert.xml -d HcalEndcapPInsert --eta 3.0:3.6:0.05
+'''
+import os
+import re
+import sys
+import shutil
+import argparse
+import tempfile
+import subprocess
+import pandas as pd
+
+
+# copy of the detector path with the compact files copied and everything else linked
+def homogenized_copy(detector_path, det_name, dest):
+    for entry in os.listdir(detector_path):
+        src = os.path.join(detector_path, entry)
+        if entry == 'compact':
+            shutil.copytree(src, os.path.join(dest, entry), symlinks=True)
+        else:
+            os.symlink(src, os.path.join(dest, entry))
+    # switch the mode in the <detector> tag of det_name
+    tag_re = re.compile(r'<detector\b[^>]*\bname\s*=\s*"{}"[^>]*>'.format(re.escape(det_name)))
+    switched = []
+    for root, _, files in os.walk(os.path.join(dest, 'compact')):
+        for f in files:
+            if not f.endswith('.xml'):
+                continue
+            path = os.path.join(root, f)
+            with open(path) as fin:
+                text = fin.read()
+            new_text = tag_re.sub(lambda m: re.sub(r'\bmode\s*=\s*"full"', 'mode="homogenized"',
+                                                   m.group(0)), text)
+            if new_text != text:
+                with open(path, 'w') as fout:
+                    fout.write(new_text)
+                switched.append(path)
+    return switched
+
+
+# material budget per ray crossed in det_name
+def scan(compact, det_name, args, env, output):
+    cmd = ['geoPluginRun', '-input', compact, '-plugin', 'epic_MaterialScan',
+           'eta:' + args.eta, 'phi:' + args.phi, 'start:' + args.start, 'output:' + output]
+    subprocess.run(cmd, env=env, check=True)
+    df = pd.read_csv(output)
+    df = df[df['detector'] == det_name]
+    return df.groupby(['eta', 'phi'])[['X0', 'lambda']].sum()
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument('-c', '--compact', dest='compact', required=True,
+                        help='Top-level xml file of the detector description, in $DETECTOR_PATH.')
+    parser.add_argument('-d', '--detector', dest='detector', required=True,
+                        help='Name of the detector with a full/homogenized mode.')
+    parser.add_argument('--eta', default='-4:4:0.1', help='Pseudorapidities <min>:<max>:<step>.')
+    parser.add_argument('--phi', default='0:360:10', help='Azimuthal angles <min>:<max>:<step> (degrees).')
+    parser.add_argument('--start', default='0,0,0', help='Start point of the rays x,y,z (cm).')
+    parser.add_argument('--tolerance', type=float, default=0.005,
+                        help='Relative tolerance on the total over all rays.')
+    parser.add_argument('--ray-tolerance', type=float, default=0.01,
+                        help='Relative tolerance per ray.')
+    parser.add_argument('--max-outliers', type=float, default=0.05,
+                        help='Fraction of the rays crossing the detector allowed beyond the per ray tolerance.')
+    args = parser.parse_args()
+
+    detector_path = os.environ['DETECTOR_PATH']
+    with tempfile.TemporaryDirectory() as tmp:
+        dest = os.path.join(tmp, 'detector')
+        os.mkdir(dest)
+        switched = homogenized_copy(detector_path, args.detector, dest)
+        if not switched:
+            print('no <detector name="{}" mode="full"> found in {}/compact'.format(args.detector, detector_path))
+            sys.exit(1)
+        env = dict(os.environ, DETECTOR_PATH=dest)
+        compact_homogenized = os.path.join(dest, os.path.relpath(os.path.abspath(args.compact), detector_path))
+        full = scan(args.compact, args.detector, args, dict(os.environ), os.path.join(tmp, 'full.csv'))
+        homogenized = scan(compact_homogenized, args.detector, args, env, os.path.join(tmp, 'homogenized.csv'))
+
+    if full.empty:
+        print('no ray crosses {}, adjust --eta/--phi/--start'.format(args.detector))
+        sys.exit(1)
+    both = full.join(homogenized, how='outer', lsuffix='_full', rsuffix='_homogenized').fillna(0.)
+    failed = False
+    for col in ['X0', 'lambda']:
+        f, h = both[col + '_full'], both[col + '_homogenized']
+        total_diff = abs(h.sum() - f.sum()) / f.sum()
+        outliers = (abs(h - f) > args.ray_tolerance * f.combine(h, max)).mean()
+        print('{} {}: full {:.2f}, homogenized {:.2f} over {} rays, total differs by {:.3%}, '
+              '{:.1%} of the rays differ by more than {:.1%}'.format(
+                  args.detector, col, f.sum(), h.sum(), len(both), total_diff, outliers, args.ray_tolerance))
+        if total_diff > args.tolerance or outliers > args.max_outliers:
+            failed = True
+    sys.exit(1 if failed else 0)
@@ -0,0 +1,84 @@
+# SPDX-License-Identifier: LGPL-3.0-or-later
+# Copyright (C) 2026 ePIC Collaboration
+'''
+    A script to compare the placed LFHCAL modules with the reference module positions
+    use case:
+    python scripts/subdetector_tests/lfhcal_module_positions.py -c $DETECTOR_PATH/epic_lfhcal_only.xml
+'''
+import os
+import sys
+import dd4hep
+import argparse
+
+
+# read the reference rows of one variant as a set of (type, x, y, moduleIDx, moduleIDy)
+def read_reference(path, variant):
+    rows = set()
+    with open(path) as f:
+        for line in f:
+            line = line.split('#')[0].split()
+            if not line or line[0] != variant:
+                continue
+            mtype, x, y, idx, idy = line[1:]
+            rows.add((mtype, round(float(x), 3), round(float(y), 3), int(idx), int(idy)))
+    return rows
+
+
+# collect the placed modules as (type, x, y, moduleIDx, moduleIDy), in the compact frame
+def placed_modules(desc, det_name):
+    widths = {
+        '8M': desc.constantAsDouble('EightM_OuterWidth'),
+        '4M': desc.constantAsDouble('FourM_OuterWidth'),
+    }
+    rows = []
+    # modules are placed in an assembly, inside the detector envelope
+    env_vol = desc.detector(det_name).placement().volume()
+    for i in range(env_vol.GetNdaughters()):
+        assembly = env_vol.GetNode(i).GetVolume()
+        for j in range(assembly.GetNdaughters()):
+            node = assembly.GetNode(j)
+            ids = {p.first: p.second for p in dd4hep.PlacedVolume(node).volIDs()}
+            if 'moduletype' not in ids:
+                continue
+            mtype = '8M' if ids['moduletype'] == 0 else '4M'
+            tr = node.GetMatrix().GetTranslation()
+            # the builder places a module at (-x - width/2, -y) for a position (x, y)
+            x = -tr[0] - 0.5 * widths[mtype]
+            y = -tr[1]
+            rows.append((mtype, round(x / dd4hep.cm, 3), round(y / dd4hep.cm, 3),
+                         ids['moduleIDx'], ids['moduleIDy']))
+    return rows
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument('-c', '--compact', dest='compact', required=True,
+                        help='Top-level xml file of the detector description.')
+    parser.add_argument('-r', '--reference', dest='reference',
+                        default=os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                             'lfhcal_module_positions.txt'),
+                        help='Reference module positions.')
+    parser.add_argument('--detector', dest='detector', default='LFHCAL',
+                        help='Name of the LFHCAL detector.')
+    args = parser.parse_args()
+
+    desc = dd4hep.Detector.getInstance()
+    desc.fromXML(args.compact)
+
+    variant = 'with_insert' if desc.constantAsDouble('LFHCAL_with_space_for_insert') else 'without_insert'
+    reference = read_reference(args.reference, variant)
+    placed = placed_modules(desc, args.detector)
+
+    failed = False
+    if len(placed) != len(set(placed)):
+        print('duplicate module placements: {}'.format(len(placed) - len(set(placed))))
+        failed = True
+    for row in sorted(set(placed) - reference):
+        print('unexpected module: {} x={} y={} moduleIDx={} moduleIDy={}'.format(*row))
+        failed = True
+    for row in sorted(reference - set(placed)):
+        print('missing module: {} x={} y={} moduleIDx={} moduleIDy={}'.format(*row))
+        failed = True
+    print('{}: {} modules placed, {} in reference ({})'.format(
+        args.detector, len(placed), len(reference), variant))
+    sys.exit(1 if failed else 0)
@@ -10,6 +10,7 @@
 #include "Math/Point2D.h"
 #include <XML/Helper.h>
 #include <vector>
+#include "ConstructionProfiler.h"
 
 //////////////////////////////////////////////////
 // Far Forward B0 Electromagnetic Calorimeter
@@ -104,4 +105,4 @@ static tuple<Volume, Position> build_module(Detector& desc, xml::Collection_t& p
   }
 }
 
-DECLARE_DETELEMENT(B0_ECAL, createDetector)
+DECLARE_PROFILED_DETELEMENT(B0_ECAL, createDetector)
@@ -3,6 +3,7 @@
 
 #include "DD4hep/DetFactoryHelper.h"
 #include <map>
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -209,4 +210,4 @@ static Ref_t create_B0Preshower(Detector& description, xml_h e, SensitiveDetecto
 }
 
 // clang-format off
-DECLARE_DETELEMENT(ip6_B0Preshower, create_B0Preshower)
+DECLARE_PROFILED_DETELEMENT(ip6_B0Preshower, create_B0Preshower)
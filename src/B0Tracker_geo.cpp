@@ -8,9 +8,10 @@
 #include "DDRec/Surface.h"
 #include "XML/Layering.h"
 #include "XML/Utilities.h"
-#include <array>
 #include <map>
 #include "DD4hepDetectorHelper.h"
+#include "TrackerModuleBuilder.h"
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -23,7 +24,6 @@ using namespace dd4hep::detail;
  *
  */
 static Ref_t create_B0Tracker(Detector& description, xml_h e, SensitiveDetector sens) {
-  typedef vector<PlacedVolume> Placements;
   xml_det_t x_det = e;
   Material vacuum = description.vacuum();
   int det_id      = x_det.id();
@@ -37,10 +37,7 @@ static Ref_t create_B0Tracker(Detector& description, xml_h e, SensitiveDetector
   int m_id = 0, c_id = 0, n_sensor = 0;
   PlacedVolume pv;
 
-  map<string, Volume> modules;
-  map<string, Placements> sensitives;
-  map<string, std::vector<VolPlane>> volplane_surfaces;
-  map<string, std::array<double, 2>> module_thicknesses;
+  map<string, epic::tracker::ModuleType> module_types;
 
   // Set detector type flag
   dd4hep::xml::setDetectorTypeFlag(x_det, sdet);
@@ -61,16 +58,15 @@ static Ref_t create_B0Tracker(Detector& description, xml_h e, SensitiveDetector
     string m_nam     = x_mod.nameStr();
     xml_comp_t trd   = x_mod.trd();
 
-    double posY;
-    double x1 = trd.x1();
-    double x2 = trd.x2();
-    double z  = trd.z();
-    double y1, y2, total_thickness = 0.;
-    xml_coll_t ci(x_mod, _U(module_component));
-    for (ci.reset(), total_thickness = 0.0; ci; ++ci)
-      total_thickness += xml_comp_t(ci).thickness();
+    double x1                           = trd.x1();
+    double x2                           = trd.x2();
+    double z                            = trd.z();
+    epic::tracker::ModuleStack stack    = epic::tracker::stackComponents(x_mod);
+    double total_thickness              = stack.total_thickness;
+    epic::tracker::ModuleType& mod_type = module_types[m_nam];
 
-    y1 = y2 = total_thickness / 2;
+    double y1 = total_thickness / 2;
+    double y2 = total_thickness / 2;
     Trapezoid m_solid(x1, x2, y1, y2, z);
     Volume m_volume(m_nam, m_solid, vacuum);
     m_volume.setVisAttributes(description.visAttributes(x_mod.visStr()));
@@ -99,9 +95,10 @@ static Ref_t create_B0Tracker(Detector& description, xml_h e, SensitiveDetector
       pv = m_volume.placeVolume(f_vol, Position(f_pos.x(), f_pos.y(), f_pos.z()));
     }
 
-    double thickness_so_far = 0.0;
-    for (ci.reset(), n_sensor = 1, c_id = 0, posY = -y1; ci; ++ci, ++c_id) {
-      xml_comp_t c     = ci;
+    n_sensor = 1;
+    c_id     = 0;
+    for (auto& comp : stack.components) {
+      xml_comp_t c     = comp.x_comp;
       double c_thick   = c.thickness();
       auto comp_x1     = getAttrOrDefault(c, _Unicode(x1), x1);
       auto comp_x2     = getAttrOrDefault(c, _Unicode(x2), x2);
@@ -118,43 +115,40 @@ static Ref_t create_B0Tracker(Detector& description, xml_h e, SensitiveDetector
       Volume c_vol(c_name, comp_shape, c_mat);
 
       c_vol.setVisAttributes(description.visAttributes(c.visStr()));
-      pv = m_volume.placeVolume(c_vol, Position(0, posY + c_thick / 2, 0));
+      pv = m_volume.placeVolume(c_vol, Position(0, comp.center, 0));
       if (c.isSensitive()) {
         // std::cout << " adding sensitive volume" << c_name << "\n";
         sdet.check(n_sensor > 2,
                    "SiTrackerEndcap2::fromCompact: " + c_name + " Max of 2 modules allowed!");
         pv.addPhysVolID("sensor", n_sensor);
         c_vol.setSensitiveDetector(sens);
-        sensitives[m_nam].push_back(pv);
+        mod_type.sensors.push_back(pv);
         ++n_sensor;
 
-        module_thicknesses[m_nam] = {thickness_so_far + c_thick / 2.0,
-                                     total_thickness - thickness_so_far - c_thick / 2.0};
         // -------- create a measurement plane for the tracking surface attched to the sensitive volume -----
         Vector3D u(-1., 0., 0.);
         Vector3D v(0., -1., 0.);
         Vector3D n(0., 0., 1.);
         //    Vector3D o( 0. , 0. , 0. ) ;
 
-        // compute the inner and outer thicknesses that need to be assigned to the tracking surface
-        // depending on wether the support is above or below the sensor
-        double inner_thickness = module_thicknesses[m_nam][0];
-        double outer_thickness = module_thicknesses[m_nam][1];
-
+        // the inner and outer thicknesses that need to be assigned to the tracking surface
+        // depend on wether the support is above or below the sensor
         SurfaceType type(SurfaceType::Sensitive);
 
         // if( isStripDetector )
         //  type.setProperty( SurfaceType::Measurement1D , true ) ;
 
-        VolPlane surf(c_vol, type, inner_thickness, outer_thickness, u, v, n); //,o ) ;
-        volplane_surfaces[m_nam].push_back(surf);
+        VolPlane surf(c_vol, type, comp.inner_thickness, comp.outer_thickness, u, v, n); //,o ) ;
+        mod_type.descriptors.emplace_back("XZY", surf);
       }
-      posY += c_thick;
-      thickness_so_far += c_thick;
+      ++c_id;
     }
-    modules[m_nam] = m_volume;
+    mod_type.volume = m_volume;
   }
 
+  // rings with the same layout share one placement plan
+  epic::tracker::PlacementCache<epic::tracker::RingLayout> ring_plans;
+
   for (xml_coll_t li(x_det, _U(layer)); li; ++li) {
     xml_comp_t x_layer(li);
     int l_id    = x_layer.id();
@@ -187,41 +181,24 @@ static Ref_t create_B0Tracker(Detector& description, xml_h e, SensitiveDetector
         DD4hepDetectorHelper::ensureExtension<dd4hep::rec::VariantParameters>(layer_element);
 
     for (xml_coll_t ri(x_layer, _U(ring)); ri; ++ri) {
-      xml_comp_t x_ring    = ri;
-      double r             = x_ring.r();
-      double phi0          = x_ring.phi0(0);
-      double zstart        = x_ring.zstart();
-      double dz            = x_ring.dz(0);
-      int nmodules         = x_ring.nmodules();
-      string m_nam         = x_ring.moduleStr();
-      Volume m_vol         = modules[m_nam];
-      double iphi          = 2 * M_PI / nmodules;
-      double dphi          = dd4hep::getAttrOrDefault(x_ring, _Unicode(dphi), iphi);
-      double phi           = phi0;
-      Placements& sensVols = sensitives[m_nam];
-
-      for (int k = 0; k < nmodules; ++k) {
+      xml_comp_t x_ring                         = ri;
+      const epic::tracker::ModuleType& mod_type = module_types[x_ring.moduleStr()];
+      epic::tracker::RingLayout layout;
+      layout.r        = x_ring.r();
+      layout.phi0     = x_ring.phi0(0);
+      layout.nmodules = x_ring.nmodules();
+      layout.z        = x_ring.zstart();
+      layout.dz       = x_ring.dz(0);
+      // the modules go around the full ring unless dphi is given
+      layout.dphi = dd4hep::getAttrOrDefault(x_ring, _Unicode(dphi), 2 * M_PI / layout.nmodules);
+
+      for (auto& tr : ring_plans.plan(layout)) {
         string m_base = _toString(l_id, "layer%d") + _toString(mod_num, "_module%d");
-        double x      = -r * std::cos(phi);
-        double y      = -r * std::sin(phi);
-
-        // if (!reflect) {
         DetElement module(layer_element, m_base + "_pos", det_id);
-        pv = layer_vol.placeVolume(m_vol, Transform3D(RotationZYX(0, -M_PI / 2 - phi, -M_PI / 2),
-                                                      Position(x, y, zstart + dz)));
+        pv = layer_vol.placeVolume(mod_type.volume, tr);
         pv.addPhysVolID("layer", l_id).addPhysVolID("module", mod_num);
         module.setPlacement(pv);
-        for (size_t ic = 0; ic < sensVols.size(); ++ic) {
-          PlacedVolume sens_pv = sensVols[ic];
-          DetElement comp_elt(module, sens_pv.volume().name(), mod_num);
-          comp_elt.setPlacement(sens_pv);
-          auto& comp_elt_params =
-              DD4hepDetectorHelper::ensureExtension<dd4hep::rec::VariantParameters>(comp_elt);
-          comp_elt_params.set<std::string>("axis_definitions", "XZY");
-          volSurfaceList(comp_elt)->push_back(volplane_surfaces[m_nam][ic]);
-        }
-        dz = -dz;
-        phi += dphi;
+        epic::tracker::addSensorElements(module, mod_type, "", mod_num);
         ++mod_num;
       }
     }
@@ -246,4 +223,4 @@ static Ref_t create_B0Tracker(Detector& description, xml_h e, SensitiveDetector
 }
 
 // clang-format off
-DECLARE_DETELEMENT(ip6_B0Tracker, create_B0Tracker)
+DECLARE_PROFILED_DETELEMENT(ip6_B0Tracker, create_B0Tracker)
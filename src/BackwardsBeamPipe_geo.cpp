@@ -16,6 +16,7 @@
 #include "DD4hep/Printout.h"
 #include "TMath.h"
 #include <XML/Helper.h>
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -74,4 +75,4 @@ static Ref_t create_detector(Detector& det, xml_h e, SensitiveDetector /* sens *
   return sdet;
 }
 
-DECLARE_DETELEMENT(BackwardsBeamPipe, create_detector)
+DECLARE_PROFILED_DETELEMENT(BackwardsBeamPipe, create_detector)
@@ -5,6 +5,7 @@
 #include "DD4hep/Printout.h"
 #include "TMath.h"
 #include <XML/Helper.h>
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -80,4 +81,4 @@ static Ref_t createDetector(Detector& lccdd, xml_h e, SensitiveDetector /*sens*/
   return det;
 }
 
-DECLARE_DETELEMENT(BackwardsLumiVac, createDetector)
+DECLARE_PROFILED_DETELEMENT(BackwardsLumiVac, createDetector)
@@ -6,6 +6,7 @@
 #include "DD4hep/Printout.h"
 #include "DDRec/DetectorData.h"
 #include "DDRec/Surface.h"
+#include "ConstructionProfiler.h"
 
 //////////////////////////////////////////////////
 // Far backwards vacuum drift volume
@@ -405,4 +406,4 @@ static void Make_Tagger(Detector& desc, xml_coll_t& mod, Assembly& env, DetEleme
   }
 }
 
-DECLARE_DETELEMENT(BackwardsTagger, create_detector)
+DECLARE_PROFILED_DETELEMENT(BackwardsTagger, create_detector)
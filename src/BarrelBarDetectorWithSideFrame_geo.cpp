@@ -20,6 +20,7 @@
 #include "DDRec/Surface.h"
 #include "XML/Layering.h"
 #include <array>
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -251,5 +252,5 @@ static Ref_t create_BarrelBarDetectorWithSideFrame(Detector& description, xml_h
 
 //@}
 // clang-format off
-DECLARE_DETELEMENT(epic_BarrelBarDetectorWithSideFrame, create_BarrelBarDetectorWithSideFrame)
-DECLARE_DETELEMENT(epic_FakeDIRC, create_BarrelBarDetectorWithSideFrame)
+DECLARE_PROFILED_DETELEMENT(epic_BarrelBarDetectorWithSideFrame, create_BarrelBarDetectorWithSideFrame)
+DECLARE_PROFILED_DETELEMENT(epic_FakeDIRC, create_BarrelBarDetectorWithSideFrame)
@@ -21,8 +21,10 @@
 #include "TGeoPolygon.h"
 #include "XML/Layering.h"
 #include <functional>
+#include <memory>
 
 #include "DD4hepDetectorHelper.h"
+#include "ConstructionProfiler.h"
 
 using namespace dd4hep;
 
@@ -44,6 +46,17 @@ static Ref_t create_detector(Detector& desc, xml_h e, SensitiveDetector sens) {
   double dphi               = (2 * M_PI / nsides);
   double half_dphi          = dphi / 2;
 
+  // full: DetElements for every layer, stave, slice, module and sensor; reduced: only the layers
+  // with AstroPix staves get DetElements (down to the sensors that tracking needs), the other
+  // volumes are addressed by their volume IDs and the placement index of the detector
+  std::string hierarchy = getAttrOrDefault<std::string>(x_detector, _Unicode(hierarchy), "full");
+  bool reduced          = (hierarchy == "reduced");
+  if (!reduced && hierarchy != "full") {
+    printout(ERROR, "BarrelCalorimeterImaging",
+             "unknown hierarchy \"%s\", expected full or reduced", hierarchy.c_str());
+    throw std::runtime_error("BarrelCalorimeterImaging: unknown hierarchy " + hierarchy);
+  }
+
   DetElement sdet(detector_name, detector_id);
   Volume mother_volume = desc.pickMotherVolume(sdet);
 
@@ -58,8 +71,16 @@ static Ref_t create_detector(Detector& desc, xml_h e, SensitiveDetector sens) {
   detector_physvol.addPhysVolID("system", detector_id);
   sdet.setPlacement(detector_physvol);
 
+  // placement index: radial center, thickness and DetElement flag of every layer
+  auto& index = DD4hepDetectorHelper::ensureExtension<dd4hep::rec::VariantParameters>(sdet);
+
+  // all sensors share one set of parameters
+  auto sensor_params = std::make_shared<dd4hep::rec::VariantParameters>();
+  sensor_params->set<std::string>("axis_definitions", "XYZ");
+
   // build a single sector
   DetElement sector_element("sector0", detector_id);
+  int sector_elements = 1;
   Assembly sector_volume("sector");
   if (x_detector.hasChild(_Unicode(sectors))) {
     xml_comp_t x_sectors = x_detector.child(_Unicode(sectors));
@@ -206,6 +227,12 @@ static Ref_t create_detector(Detector& desc, xml_h e, SensitiveDetector sens) {
     double layer_space_before  = getAttrOrDefault(x_layer, _Unicode(space_before), 0.);
     layer_pos_z += layer_space_before;
 
+    bool layer_has_sensors = false;
+    for (xml_coll_t i_stave(x_layer, _U(stave)); i_stave; ++i_stave) {
+      layer_has_sensors |= xml_comp_t(i_stave).hasChild(_Unicode(xy_layout));
+    }
+    bool layer_has_element = !reduced || layer_has_sensors;
+
     // Loop over number of repeats for this layer.
     for (int layer_j = 0; layer_j < layer_repeat; layer_j++) {
 
@@ -222,7 +249,11 @@ static Ref_t create_detector(Detector& desc, xml_h e, SensitiveDetector sens) {
       double layer_trd_z  = layer_thickness / 2; // account for frame
       Trapezoid layer_shape(layer_trd_x1, layer_trd_x2, layer_trd_y1, layer_trd_y2, layer_trd_z);
       Volume layer_volume(layer_name, layer_shape, layer_mat);
-      DetElement layer_element(sector_element, layer_name, detector_id);
+      DetElement layer_element;
+      if (layer_has_element) {
+        layer_element = DetElement(sector_element, layer_name, detector_id);
+        ++sector_elements;
+      }
 
       // Set region, limitset, and vis of layer.
       layer_volume.setAttributes(desc, x_layer.regionStr(), x_layer.limitsStr(), x_layer.visStr());
@@ -250,7 +281,11 @@ static Ref_t create_detector(Detector& desc, xml_h e, SensitiveDetector sens) {
         Volume stave_volume(stave_name, stave_shape, stave_material);
         stave_volume.setAttributes(desc, x_stave.regionStr(), x_stave.limitsStr(),
                                    x_stave.visStr());
-        DetElement stave_element(layer_element, stave_name, detector_id);
+        DetElement stave_element;
+        if (!reduced || x_stave.hasChild(_Unicode(xy_layout))) {
+          stave_element = DetElement(layer_element, stave_name, detector_id);
+          ++sector_elements;
+        }
 
         // Loop over the slices for this stave
         double slice_pos_z = -(stave_thick / 2.);
@@ -286,6 +321,7 @@ static Ref_t create_detector(Detector& desc, xml_h e, SensitiveDetector sens) {
               // Create module
               std::string module_name = _toString(i_module, "module%d");
               DetElement module_element(stave_element, module_name, i_module);
+              ++sector_elements;
 
               // Place module
               auto x = x0 + i_x * dx;
@@ -300,11 +336,8 @@ static Ref_t create_detector(Detector& desc, xml_h e, SensitiveDetector sens) {
                 DetElement sensitive_element(module_element, sensitive_physvol.volume().name(),
                                              i_module);
                 sensitive_element.setPlacement(sensitive_physvol);
-
-                auto& sensitive_element_params =
-                    DD4hepDetectorHelper::ensureExtension<dd4hep::rec::VariantParameters>(
-                        sensitive_element);
-                sensitive_element_params.set<std::string>("axis_definitions", "XYZ");
+                DD4hepDetectorHelper::addSharedExtension(sensitive_element, sensor_params);
+                ++sector_elements;
               }
 
               i_module++;
@@ -326,7 +359,6 @@ static Ref_t create_detector(Detector& desc, xml_h e, SensitiveDetector sens) {
           Volume slice_volume(slice_name, slice_shape, desc.material(x_slice.materialStr()));
           slice_volume.setAttributes(desc, x_slice.regionStr(), x_slice.limitsStr(),
                                      x_slice.visStr());
-          DetElement slice_element(stave_element, slice_name, detector_id);
 
           // Set sensitive
           if (x_slice.isSensitive()) {
@@ -337,7 +369,11 @@ static Ref_t create_detector(Detector& desc, xml_h e, SensitiveDetector sens) {
           PlacedVolume slice_physvol =
               stave_volume.placeVolume(slice_volume, Position(0, 0, slice_pos_z + slice_thick / 2));
           slice_physvol.addPhysVolID("slice", slice_num);
-          slice_element.setPlacement(slice_physvol);
+          if (!reduced) {
+            DetElement slice_element(stave_element, slice_name, detector_id);
+            slice_element.setPlacement(slice_physvol);
+            ++sector_elements;
+          }
 
           // Increment Z position of slice
           slice_pos_z += slice_thick;
@@ -353,7 +389,9 @@ static Ref_t create_detector(Detector& desc, xml_h e, SensitiveDetector sens) {
           Transform3D stave_tr(stave_rot, stave_pos);
           PlacedVolume stave_physvol = layer_volume.placeVolume(stave_volume, stave_tr);
           stave_physvol.addPhysVolID("stave", stave_num);
-          stave_element.setPlacement(stave_physvol);
+          if (stave_element.isValid()) {
+            stave_element.setPlacement(stave_physvol);
+          }
 
           // Increment X position of stave
           stave_pos_x += stave_pitch;
@@ -402,7 +440,12 @@ static Ref_t create_detector(Detector& desc, xml_h e, SensitiveDetector sens) {
       // Place layer into sector
       PlacedVolume layer_physvol = sector_volume.placeVolume(layer_volume, layer_pos);
       layer_physvol.addPhysVolID("layer", layer_num);
-      layer_element.setPlacement(layer_physvol);
+      if (layer_has_element) {
+        layer_element.setPlacement(layer_physvol);
+      }
+      index.set<double>(_toString(layer_num, "layer%d_r"), layer_pos_z + layer_thickness / 2.);
+      index.set<double>(_toString(layer_num, "layer%d_thickness"), layer_thickness);
+      index.set<bool>(_toString(layer_num, "layer%d_detelement"), layer_has_element);
 
       // Increment to next layer Z position. Do not add space_between for the last layer
       layer_pos_z += layer_thickness;
@@ -425,6 +468,8 @@ static Ref_t create_detector(Detector& desc, xml_h e, SensitiveDetector sens) {
     sd.setPlacement(sector_physvol);
     sdet.add(sd);
   }
+  printout(INFO, "BarrelCalorimeterImaging", "%s: %s hierarchy, %d DetElements per sector",
+           detector_name.c_str(), hierarchy.c_str(), sector_elements);
 
   return sdet;
 }
@@ -445,4 +490,4 @@ static void buildSupport(Detector& desc, Volume& sector_volume, xml_comp_t x_sup
   s_vol.setVisAttributes(desc.visAttributes(x_support.visStr()));
   sector_volume.placeVolume(s_vol, Position(0.0, 0.0, pos_z + support_thickness / 2.));
 }
-DECLARE_DETELEMENT(epic_EcalBarrelImaging, create_detector)
+DECLARE_PROFILED_DETELEMENT(epic_EcalBarrelImaging, create_detector)
@@ -15,45 +15,68 @@
 //     issue dealing with it. C. Peng
 
 #include "DD4hep/DetFactoryHelper.h"
+#include "DD4hep/Printout.h"
 #include "Math/Point2D.h"
-#include "TGeoPolygon.h"
 #include "XML/Layering.h"
-#include <functional>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include "ConstructionProfiler.h"
+#include "FiberLatticeSegmentation.h"
+#include "SliceMixture.h"
+#include "ScFiGrids.h"
 
 using namespace dd4hep;
 
-typedef ROOT::Math::XYPoint Point;
-// fiber placement helpers, defined below
-struct FiberGrid {
-  int ix = 0, iy = 0;
-  std::vector<Point> points;
-  Point mean_centroid    = Point(0., 0.);
-  Assembly* assembly_ptr = nullptr;
-
-  // initialize with grid id and points
-  FiberGrid(int i, int j, const std::vector<Point>& pts) : ix(i), iy(j), points(pts) {
-    if (pts.empty()) {
-      return;
-    }
+using epic::scfi::assignGrids;
+using epic::scfi::FiberGrid;
+using epic::scfi::fiberPositions;
+using epic::scfi::gridPoints;
+using epic::scfi::Point;
+
+// fiber lattice parameters of one slice
+struct FiberLayout {
+  int layer_number = 0;
+  double radius    = 0.;
+  double spacing_x = 0.;
+  double spacing_z = 0.;
+  int grid_n_phi   = 0;
+  double grid_dr   = 0.;
+  double trd_x1    = 0.;
+  double thickness = 0.;
+  double hphi      = 0.;
+};
 
-    double mx = 0., my = 0.;
-    for (auto& p : pts) {
-      mx += p.x();
-      my += p.y();
-    }
-    mx /= static_cast<double>(pts.size());
-    my /= static_cast<double>(pts.size());
-    mean_centroid = Point(mx, my);
-  };
+// fiber lattice of one slice: the readout grids and the fibers of each grid, in fiber order
+// Planning only uses plain geometry on the layout (no TGeo objects, no XML), so slices can be
+// planned concurrently without ROOT thread safety.
+struct FiberPlan {
+  std::vector<FiberGrid> grids;
+  std::vector<std::vector<Point>> grid_fibers;
+};
+
+// a slice waiting for its fibers
+struct FiberSlice {
+  Volume s_vol;
+  xml_comp_t x_fiber;
+  double s_length;
+  FiberLayout layout;
 };
 
-std::vector<Point> fiberPositions(double r, double sx, double sz, double trx, double trz,
-                                  double phi, bool shift_first = false, double stol = 1e-2);
-std::vector<FiberGrid> gridPoints(int div_n_phi, double div_dr, double x, double z, double phi);
+FiberLayout fiberLayout(xml_comp_t x_fiber, int layer_number,
+                        const std::tuple<double, double, double>& dimensions);
+FiberPlan planFibers(const FiberLayout& layout);
+std::vector<FiberPlan> planFibers(const std::vector<FiberSlice>& slices, unsigned n_threads);
+double sliceArea(const FiberLayout& layout);
+double fiberFraction(const FiberLayout& layout, const FiberPlan& plan);
 
 // geometry helpers
-void buildFibers(Detector& desc, SensitiveDetector& sens, Volume& mother, int layer_nunber,
-                 xml_comp_t x_fiber, const std::tuple<double, double, double, double>& dimensions);
+void buildFibers(Detector& desc, SensitiveDetector& sens, const FiberSlice& slice,
+                 const FiberPlan& plan);
+void buildHomogenizedFibers(Detector& desc, SensitiveDetector& sens, const FiberSlice& slice,
+                            const FiberPlan& plan);
 void buildSupport(Detector& desc, Volume& mother, xml_comp_t x_support,
                   const std::tuple<double, double, double, double>& dimensions);
 
@@ -71,6 +94,10 @@ static Ref_t create_detector(Detector& desc, xml_h e, SensitiveDetector sens) {
   double hphi          = dphi / 2;
   std::string det_name = x_det.nameStr();
 
+  // full: individual fibers; homogenized: each readout grid is one sensitive volume of the
+  // fiber + matrix mixture, with virtual fibers from the FiberLattice segmentation
+  bool homogenized = epic::calorimeter::homogenizedMode(x_det, "BarrelCalorimeterScFi");
+
   DetElement sdet(det_name, det_id);
   Volume motherVol = desc.pickMotherVolume(sdet);
 
@@ -86,6 +113,9 @@ static Ref_t create_detector(Detector& desc, xml_h e, SensitiveDetector sens) {
   DetElement sector_det("sector0", det_id);
   Assembly mod_vol("sector");
 
+  // fibers are planned for all slices at once, see below
+  std::vector<FiberSlice> fiber_slices;
+
   // keep tracking of the total thickness
   double l_pos_z = inner_r;
   { // =====  buildBarrelStave(desc, sens, module_volume) =====
@@ -134,10 +164,11 @@ static Ref_t create_detector(Detector& desc, xml_h e, SensitiveDetector sens) {
           Volume s_vol(s_name, s_shape, desc.material(x_slice.materialStr()));
           DetElement slice(layer, s_name, det_id);
 
-          // build fibers
+          // fibers are built after all layers are planned
           if (x_slice.hasChild(_Unicode(fiber))) {
-            buildFibers(desc, sens, s_vol, l_num, x_slice.child(_Unicode(fiber)),
-                        {s_trd_x1, s_thick, l_dim_y, hphi});
+            xml_comp_t x_fiber = x_slice.child(_Unicode(fiber));
+            fiber_slices.push_back(
+                {s_vol, x_fiber, l_dim_y, fiberLayout(x_fiber, l_num, {s_trd_x1, s_thick, hphi})});
           }
 
           if (x_slice.isSensitive()) {
@@ -168,6 +199,53 @@ static Ref_t create_detector(Detector& desc, xml_h e, SensitiveDetector sens) {
       }
     }
   }
+
+  // Plan the fiber lattices of all slices (pure geometry), then create the fiber volumes
+  // serially. Each plan depends only on its slice, so the result does not depend on the number
+  // of threads: planning_threads (default 1) threads, or all cores for planning_threads="0".
+  int n_threads = getAttrOrDefault<int>(x_det, _Unicode(planning_threads), 1);
+  if (n_threads <= 0) {
+    n_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  auto fiber_plans = planFibers(fiber_slices, n_threads);
+  if (!homogenized) {
+    for (size_t i = 0; i < fiber_slices.size(); ++i) {
+      buildFibers(desc, sens, fiber_slices[i], fiber_plans[i]);
+    }
+  } else if (!fiber_slices.empty()) {
+    // the lattice is shared by all slices, with the readout grids shifted by half a pitch in
+    // the layers whose first row is shifted (see buildHomogenizedFibers)
+    auto* lattice =
+        dynamic_cast<epic::FiberLattice*>(sens.readout().segmentation().segmentation());
+    if (lattice == nullptr) {
+      printout(ERROR, "BarrelCalorimeterScFi", "homogenized mode needs a FiberLattice readout");
+      throw std::runtime_error("BarrelCalorimeterScFi: homogenized mode needs FiberLattice");
+    }
+    const FiberLayout& first = fiber_slices.front().layout;
+    lattice->setLattice(first.spacing_x, first.spacing_z, 0., 0., first.spacing_x / 2., 0);
+
+    double fiber_mass = 0., total_mass = 0.;
+    for (size_t i = 0; i < fiber_slices.size(); ++i) {
+      auto& fs = fiber_slices[i];
+      if (fs.layout.spacing_x != first.spacing_x || fs.layout.spacing_z != first.spacing_z) {
+        printout(ERROR, "BarrelCalorimeterScFi", "homogenized mode needs equal fiber spacings");
+        throw std::runtime_error("BarrelCalorimeterScFi: unequal fiber spacings");
+      }
+      // slices have the same length, so masses per unit length are enough
+      double area     = sliceArea(fs.layout);
+      double fraction = fiberFraction(fs.layout, fiber_plans[i]);
+      double rho_f    = desc.material(fs.x_fiber.materialStr())->GetMaterial()->GetDensity();
+      double rho_m    = fs.s_vol.material()->GetMaterial()->GetDensity();
+      fiber_mass += area * fraction * rho_f;
+      total_mass += area * (fraction * rho_f + (1. - fraction) * rho_m);
+      buildHomogenizedFibers(desc, sens, fs, fiber_plans[i]);
+    }
+    // scintillator mass fraction, as a starting point for the sampling fraction calibration
+    desc.add(Constant(det_name + "_ScintillatorMassFraction",
+                      _toString(fiber_mass / total_mass, "%.6f")));
+    printout(INFO, "BarrelCalorimeterScFi", "%s: homogenized, scintillator mass fraction %.4f",
+             det_name.c_str(), fiber_mass / total_mass);
+  }
   // Phi start for a sector.
   double phi = M_PI / nsides;
   // Create nsides sectors.
@@ -195,19 +273,24 @@ static Ref_t create_detector(Detector& desc, xml_h e, SensitiveDetector sens) {
   return sdet;
 }
 
-void buildFibers(Detector& desc, SensitiveDetector& sens, Volume& s_vol, int layer_number,
-                 xml_comp_t x_fiber, const std::tuple<double, double, double, double>& dimensions) {
-  auto [s_trd_x1, s_thick, s_length, hphi] = dimensions;
-  double f_radius                          = getAttrOrDefault(x_fiber, _U(radius), 0.1 * cm);
-  double f_cladding_thickness = getAttrOrDefault(x_fiber, _Unicode(cladding_thickness), 0.0 * cm);
-  double f_spacing_x          = getAttrOrDefault(x_fiber, _Unicode(spacing_x), 0.122 * cm);
-  double f_spacing_z          = getAttrOrDefault(x_fiber, _Unicode(spacing_z), 0.134 * cm);
-  int grid_n_phi              = getAttrOrDefault(x_fiber, _Unicode(grid_n_phi), 5);
-  double grid_dr              = getAttrOrDefault(x_fiber, _Unicode(grid_dr), 2.0 * cm);
-  std::string f_id_grid = getAttrOrDefault<std::string>(x_fiber, _Unicode(identifier_grid), "grid");
-  std::string f_id_fiber =
-      getAttrOrDefault<std::string>(x_fiber, _Unicode(identifier_fiber), "fiber");
+FiberLayout fiberLayout(xml_comp_t x_fiber, int layer_number,
+                        const std::tuple<double, double, double>& dimensions) {
+  auto [s_trd_x1, s_thick, hphi] = dimensions;
+  FiberLayout layout;
+  layout.layer_number = layer_number;
+  layout.radius       = getAttrOrDefault(x_fiber, _U(radius), 0.1 * cm);
+  layout.spacing_x    = getAttrOrDefault(x_fiber, _Unicode(spacing_x), 0.122 * cm);
+  layout.spacing_z    = getAttrOrDefault(x_fiber, _Unicode(spacing_z), 0.134 * cm);
+  layout.grid_n_phi   = getAttrOrDefault(x_fiber, _Unicode(grid_n_phi), 5);
+  layout.grid_dr      = getAttrOrDefault(x_fiber, _Unicode(grid_dr), 2.0 * cm);
+  layout.trd_x1       = s_trd_x1;
+  layout.thickness    = s_thick;
+  layout.hphi         = hphi;
+  return layout;
+}
 
+FiberPlan planFibers(const FiberLayout& layout) {
+  FiberPlan plan;
   // Set up the readout grid for the fiber layers
   // Trapezoid is divided into segments with equal dz and equal number of divisions in x
   // Every segment is a polygon that can be attached later to the lightguide
@@ -215,6 +298,78 @@ void buildFibers(Detector& desc, SensitiveDetector& sens, Volume& s_vol, int lay
   // SiPM chip (for GlueX 13mmx13mm: 4x4 grid 3mmx3mm with 3600 50×50 μm pixels each)
   // See, e.g., https://arxiv.org/abs/1801.03088 Fig. 2d
 
+  // calculate polygonal grid coordinates (vertices)
+  plan.grids = gridPoints(layout.grid_n_phi, layout.grid_dr, layout.trd_x1, layout.thickness,
+                          layout.hphi);
+  // use layer_number % 2 to add correct shifts for the adjacent fibers at layer boundary
+  auto f_pos  = fiberPositions(layout.radius, layout.spacing_x, layout.spacing_z, layout.trd_x1,
+                               layout.thickness, layout.hphi, (layout.layer_number % 2 == 0));
+  auto f_grid = assignGrids(plan.grids, f_pos, layout.grid_n_phi, layout.trd_x1,
+                            layout.thickness, layout.hphi);
+
+  // fibers of each grid, in fiber order
+  plan.grid_fibers.resize(plan.grids.size());
+  for (size_t i = 0; i < f_pos.size(); ++i) {
+    if (f_grid[i] >= 0) {
+      plan.grid_fibers[f_grid[i]].push_back(f_pos[i]);
+    }
+  }
+
+  /*
+  // sanity check
+  size_t missing_fibers = std::count(f_grid.begin(), f_grid.end(), -1);
+  std::cout << "built " << f_pos.size() << " fibers, "
+            << missing_fibers << " of them failed to find a grid" << std::endl;
+  */
+  return plan;
+}
+
+// plan all slices on a pool of n_threads threads, plans are in slice order
+std::vector<FiberPlan> planFibers(const std::vector<FiberSlice>& slices, unsigned n_threads) {
+  std::vector<FiberPlan> plans(slices.size());
+  std::atomic<size_t> next{0};
+  auto worker = [&]() {
+    for (size_t i = next++; i < slices.size(); i = next++) {
+      plans[i] = planFibers(slices[i].layout);
+    }
+  };
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < std::min<size_t>(n_threads, slices.size()); ++t) {
+    pool.emplace_back(worker);
+  }
+  worker();
+  for (auto& th : pool) {
+    th.join();
+  }
+  return plans;
+}
+
+// cross section of the trapezoidal slice
+double sliceArea(const FiberLayout& layout) {
+  return (2. * layout.trd_x1 + layout.thickness * std::tan(layout.hphi)) * layout.thickness;
+}
+
+// volume fraction of the fibers in the slice
+double fiberFraction(const FiberLayout& layout, const FiberPlan& plan) {
+  size_t n_fibers = 0;
+  for (auto& fibers : plan.grid_fibers) {
+    n_fibers += fibers.size();
+  }
+  return n_fibers * M_PI * layout.radius * layout.radius / sliceArea(layout);
+}
+
+void buildFibers(Detector& desc, SensitiveDetector& sens, const FiberSlice& slice,
+                 const FiberPlan& plan) {
+  Volume s_vol                = slice.s_vol;
+  xml_comp_t x_fiber          = slice.x_fiber;
+  double s_length             = slice.s_length;
+  double f_radius             = getAttrOrDefault(x_fiber, _U(radius), 0.1 * cm);
+  double f_cladding_thickness = getAttrOrDefault(x_fiber, _Unicode(cladding_thickness), 0.0 * cm);
+  int grid_n_phi              = getAttrOrDefault(x_fiber, _Unicode(grid_n_phi), 5);
+  std::string f_id_grid = getAttrOrDefault<std::string>(x_fiber, _Unicode(identifier_grid), "grid");
+  std::string f_id_fiber =
+      getAttrOrDefault<std::string>(x_fiber, _Unicode(identifier_fiber), "fiber");
+
   // fiber and its cladding
   double f_radius_core = f_radius - f_cladding_thickness;
   Tube f_tube_clad(0, f_radius, s_length);
@@ -227,74 +382,72 @@ void buildFibers(Detector& desc, SensitiveDetector& sens, Volume& s_vol, int lay
   f_vol_core.setAttributes(desc, x_fiber.regionStr(), x_fiber.limitsStr(), x_fiber.visStr());
   f_vol_clad.placeVolume(f_vol_core);
 
-  // calculate polygonal grid coordinates (vertices)
-  auto grids = gridPoints(grid_n_phi, grid_dr, s_trd_x1, s_thick, hphi);
-  std::vector<int> f_id_count(grids.size(), 0);
-  // use layer_number % 2 to add correct shifts for the adjacent fibers at layer boundary
-  auto f_pos = fiberPositions(f_radius, f_spacing_x, f_spacing_z, s_trd_x1, s_thick, hphi,
-                              (layer_number % 2 == 0));
-  // a helper struct to speed up searching
-  struct Fiber {
-    Point pos;
-    bool assigned = false;
-    Fiber(const Point& p) : pos(p) {};
-  };
-  std::vector<Fiber> fibers(f_pos.begin(), f_pos.end());
-
   // build assembly for each grid and put fibers in
-  for (auto& gr : grids) {
+  for (size_t i = 0; i < plan.grids.size(); ++i) {
+    auto& gr = plan.grids[i];
+    // only add this if this grid has fibers
+    if (plan.grid_fibers[i].empty()) {
+      continue;
+    }
     Assembly grid_vol(Form("fiber_grid_%i_%i", gr.ix, gr.iy));
 
-    // loop over all fibers that are not assigned to a grid
+    // place fibers in grid
     int f_id = 1;
-    for (auto& fi : fibers) {
-      if (fi.assigned) {
-        continue;
-      }
-
-      // use TGeoPolygon to help check if fiber is inside a grid
-      TGeoPolygon poly(gr.points.size());
-      std::vector<double> vx, vy;
-      std::transform(gr.points.begin(), gr.points.end(), back_inserter(vx), std::mem_fn(&Point::x));
-      std::transform(gr.points.begin(), gr.points.end(), back_inserter(vy), std::mem_fn(&Point::y));
-      poly.SetXY(vx.data(), vy.data());
-      poly.FinishPolygon();
-
-      double f_xy[2] = {fi.pos.x(), fi.pos.y()};
-      if (not poly.Contains(f_xy)) {
-        continue;
-      }
-
-      // place fiber in grid
-      auto p        = fi.pos - gr.mean_centroid;
+    for (auto& pos : plan.grid_fibers[i]) {
+      auto p        = pos - gr.mean_centroid;
       auto clad_phv = grid_vol.placeVolume(f_vol_clad, Position(p.x(), p.y(), 0.));
       clad_phv.addPhysVolID(f_id_fiber, f_id);
-      fi.assigned = true;
       f_id++;
     }
 
-    // only add this if this grid has fibers
-    if (f_id > 1) {
-      // fiber is along y-axis of the layer volume, so grids are arranged on X-Z plane
-      Transform3D gr_tr(RotationZYX(0., 0., M_PI * 0.5),
-                        Position(gr.mean_centroid.x(), 0., gr.mean_centroid.y()));
-      auto grid_phv = s_vol.placeVolume(grid_vol, gr_tr);
-      grid_phv.addPhysVolID(f_id_grid, gr.ix + gr.iy * grid_n_phi + 1);
-      grid_vol.ptr()->Voxelize("");
-    }
+    // fiber is along y-axis of the layer volume, so grids are arranged on X-Z plane
+    Transform3D gr_tr(RotationZYX(0., 0., M_PI * 0.5),
+                      Position(gr.mean_centroid.x(), 0., gr.mean_centroid.y()));
+    auto grid_phv = s_vol.placeVolume(grid_vol, gr_tr);
+    grid_phv.addPhysVolID(f_id_grid, gr.ix + gr.iy * grid_n_phi + 1);
+    grid_vol.ptr()->Voxelize("");
   }
+}
 
-  /*
-  // sanity check
-  size_t missing_fibers = 0;
-  for (auto &fi : fibers) {
-    if (not fi.assigned) {
-      missing_fibers++;
+// Homogenized slice: the slice becomes the fiber + matrix mixture, and every readout grid with
+// fibers one sensitive prism of the same mixture with the grid ID. The FiberLattice
+// segmentation then assigns the nearest (virtual) fiber and the strip along it.
+// The grid frame is the slice x-z plane, shifted by half a pitch in the layers whose first
+// row is shifted, so that one lattice describes all layers.
+void buildHomogenizedFibers(Detector& desc, SensitiveDetector& sens, const FiberSlice& slice,
+                            const FiberPlan& plan) {
+  Volume s_vol          = slice.s_vol;
+  xml_comp_t x_fiber    = slice.x_fiber;
+  std::string f_id_grid = getAttrOrDefault<std::string>(x_fiber, _Unicode(identifier_grid), "grid");
+
+  Material mix =
+      epic::calorimeter::fiberMixture(desc, s_vol.material(), desc.material(x_fiber.materialStr()),
+                                      fiberFraction(slice.layout, plan));
+  s_vol.setMaterial(mix);
+
+  double shift = (slice.layout.layer_number % 2 == 0) ? slice.layout.spacing_x / 2. : 0.;
+  for (size_t i = 0; i < plan.grids.size(); ++i) {
+    auto& gr = plan.grids[i];
+    // only add this if this grid has fibers
+    if (plan.grid_fibers[i].empty()) {
+      continue;
+    }
+    std::vector<double> xs, ys;
+    for (auto& p : gr.points) {
+      xs.push_back(p.x() - shift);
+      ys.push_back(p.y());
     }
+    ExtrudedPolygon gr_shape(xs, ys, {-slice.s_length, slice.s_length}, {0., 0.}, {0., 0.},
+                             {1., 1.});
+    Volume grid_vol(Form("fiber_grid_%i_%i", gr.ix, gr.iy), gr_shape, mix);
+    grid_vol.setSensitiveDetector(sens);
+    grid_vol.setAttributes(desc, x_fiber.regionStr(), x_fiber.limitsStr(), x_fiber.visStr());
+
+    // fiber is along y-axis of the layer volume, so grids are arranged on X-Z plane
+    Transform3D gr_tr(RotationZYX(0., 0., M_PI * 0.5), Position(shift, 0., 0.));
+    auto grid_phv = s_vol.placeVolume(grid_vol, gr_tr);
+    grid_phv.addPhysVolID(f_id_grid, gr.ix + gr.iy * slice.layout.grid_n_phi + 1);
   }
-  std::cout << "built " << fibers.size() << " fibers, "
-            << missing_fibers << " of them failed to find a grid" << std::endl;
-  */
 }
 
 // simple aluminum sheet cover
@@ -314,101 +467,4 @@ void buildSupport(Detector& desc, Volume& mod_vol, xml_comp_t x_support,
   mod_vol.placeVolume(s_vol, Position(0.0, 0.0, pos_z + support_thickness / 2.));
 }
 
-// Fill fiber lattice into trapezoid starting from position (0,0) in x-z coordinate system
-std::vector<Point> fiberPositions(double r, double sx, double sz, double trx, double trz,
-                                  double phi, bool shift, double stol) {
-  // r      - fiber radius
-  // sx, sz - spacing between fibers in x, z
-  // trx    - half-length of the shorter (bottom) base of the trapezoid
-  // trz    - height of the trapezoid
-  // phi    - angle between z and trapezoid arm
-  // stol   - spacing tolerance
-
-  std::vector<Point> positions;
-  int z_layers = floor((trz / 2 - r - stol) / sz); // number of layers that fits in half trapezoid-z
-
-  double px = 0., pz = 0.;
-  int start_line = shift ? 1 : 0;
-
-  for (int l = -z_layers; l < z_layers + 1; l++) {
-    std::vector<Point> xline;
-    pz           = l * sz;
-    double x_max = trx + (trz / 2. + pz) * tan(phi) - stol; // calculate max x at particular z_pos
-    (abs(l) % 2 == start_line) ? px = 0. : px = sx / 2;     // account for spacing/2 shift
-
-    while (px < (x_max - r)) {
-      xline.push_back(Point(px, pz));
-      if (px != 0.)
-        xline.push_back(Point(-px, pz)); // using symmetry around x=0
-      px += sx;
-    }
-
-    // Sort fiber IDs for a better organization
-    sort(xline.begin(), xline.end(),
-         [](const Point& p1, const Point& p2) { return p1.x() < p2.x(); });
-    positions.insert(positions.end(), xline.begin(), xline.end());
-  }
-  return positions;
-}
-
-// Determine the number of divisions for the readout grid for the fiber layers
-// Calculate dimensions of the polygonal grid
-std::vector<FiberGrid> gridPoints(int div_n_phi, double div_dr, double trd_x1, double height,
-                                  double phi) {
-  /*
-  // TODO: move this test to xml file
-  double SiPMsize = 13.0 * mm;
-  double grid_min = SiPMsize + 3.0 * mm;
-
-  if (dz < grid_min) {
-    dz = grid_min;
-  }
-
-  if (dx < grid_min) {
-    dx = grid_min;
-  }
-  */
-  // number of divisions
-  int nph = div_n_phi;
-  int nr  = floor(height / div_dr);
-  if (nr == 0) {
-    nr++;
-  }
-
-  // grid vertices
-  std::vector<FiberGrid> results;
-  double dr = height / nr;
-
-  for (int ir = 0; ir <= nr; ir++) {
-    for (int iph = 0; iph <= nph; iph++) {
-      double A_y = -height / 2. + ir * dr;
-      double B_y = -height / 2. + (ir + 1) * dr;
-
-      double botl_dr = 2 * (trd_x1 + ir * dr * tan(phi));
-      double topl_dr = 2 * (trd_x1 + (ir + 1) * dr * tan(phi));
-
-      double botl_dph_dr = botl_dr / nph;
-      double topl_dph_dr = topl_dr / nph;
-
-      double A_x = -botl_dr / 2. + iph * botl_dph_dr;
-      double B_x = -topl_dr / 2. + iph * topl_dph_dr;
-
-      double C_y = B_y;
-      double D_y = A_y;
-      double C_x = B_x + topl_dph_dr;
-      double D_x = A_x + botl_dph_dr;
-
-      auto A = Point(A_x, A_y);
-      auto B = Point(B_x, B_y);
-      auto C = Point(C_x, C_y);
-      auto D = Point(D_x, D_y);
-
-      // vertex points filled in the clock-wise direction
-      results.emplace_back(FiberGrid(iph, ir, {A, B, C, D}));
-    }
-  }
-
-  return results;
-}
-
-DECLARE_DETELEMENT(epic_EcalBarrelScFi, create_detector)
+DECLARE_PROFILED_DETELEMENT(epic_EcalBarrelScFi, create_detector)
@@ -4,6 +4,7 @@
 #include "DD4hep/DetFactoryHelper.h"
 #include "DD4hep/Printout.h"
 #include "XML/Utilities.h"
+#include "ConstructionProfiler.h"
 
 using namespace dd4hep;
 
@@ -49,4 +50,4 @@ static dd4hep::Ref_t create_detector(dd4hep::Detector& description, xml_h e,
   return sdet;
 }
 
-DECLARE_DETELEMENT(epic_BarrelFluxReturn, create_detector)
+DECLARE_PROFILED_DETELEMENT(epic_BarrelFluxReturn, create_detector)
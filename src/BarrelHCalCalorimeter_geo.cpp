@@ -24,11 +24,114 @@
 #include "TVector3.h"
 #include "TGDMLParse.h"
 #include "FileLoaderHelper.h"
+#include "GDMLImportCache.h"
+#include "ConstructionProfiler.h"
+#include "BarrelHCalTileTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <set>
 
 using namespace std;
 using namespace dd4hep;
 using namespace dd4hep::detail;
 
+// Returns an extruded polygon equivalent to a tessellated right prism along z, or an invalid
+// solid if the mesh is not one. The mesh qualifies when all vertices lie on the two z planes,
+// every +z vertex sits above a -z vertex, the boundary of the -z cap is a single loop, and
+// the mesh volume equals the cap area times the length.
+static Solid extrude_prism(TessellatedSolid tess, double& mesh_volume) {
+  constexpr double tol = 1e-6 * dd4hep::cm;
+  const int nvert      = tess.num_vertex();
+  const int nfacet     = tess.num_facet();
+
+  double zmin = std::numeric_limits<double>::max();
+  double zmax = -zmin;
+  for (int i = 0; i < nvert; i++) {
+    zmin = std::min(zmin, tess.vertex(i)[2]);
+    zmax = std::max(zmax, tess.vertex(i)[2]);
+  }
+  std::vector<std::pair<double, double>> bottom, top;
+  for (int i = 0; i < nvert; i++) {
+    const auto& v = tess.vertex(i);
+    if (std::abs(v[2] - zmin) < tol)
+      bottom.emplace_back(v[0], v[1]);
+    else if (std::abs(v[2] - zmax) < tol)
+      top.emplace_back(v[0], v[1]);
+    else
+      return Solid();
+  }
+  std::sort(bottom.begin(), bottom.end());
+  for (const auto& [x, y] : top) {
+    auto it    = std::lower_bound(bottom.begin(), bottom.end(),
+                                  std::make_pair(x - tol, -std::numeric_limits<double>::max()));
+    bool below = false;
+    for (; it != bottom.end() && it->first < x + tol && !below; ++it)
+      below = std::abs(it->second - y) < tol;
+    if (!below)
+      return Solid();
+  }
+
+  // mesh volume, and directed edges of the -z cap facets
+  mesh_volume = 0.0;
+  std::set<std::pair<int, int>> cap_edges;
+  for (int i = 0; i < nfacet; i++) {
+    const auto& facet = tess.facet(i);
+    const int n       = facet.GetNvert();
+    const auto& v0    = tess.vertex(facet[0]);
+    bool cap          = true;
+    for (int j = 0; j < n; j++) {
+      cap = cap && std::abs(tess.vertex(facet[j])[2] - zmin) < tol;
+      if (j > 0 && j + 1 < n) {
+        const auto& v1 = tess.vertex(facet[j]);
+        const auto& v2 = tess.vertex(facet[j + 1]);
+        mesh_volume += (v0[0] * (v1[1] * v2[2] - v1[2] * v2[1]) -
+                        v0[1] * (v1[0] * v2[2] - v1[2] * v2[0]) +
+                        v0[2] * (v1[0] * v2[1] - v1[1] * v2[0])) /
+                       6.0;
+      }
+    }
+    if (cap) {
+      for (int j = 0; j < n; j++)
+        cap_edges.emplace(facet[j], facet[(j + 1) % n]);
+    }
+  }
+  mesh_volume = std::abs(mesh_volume);
+
+  // edges shared by two cap facets appear in both directions, the rest is the outline
+  std::map<int, int> next;
+  for (const auto& [a, b] : cap_edges) {
+    if (cap_edges.count({b, a}) == 0 && !next.emplace(a, b).second)
+      return Solid();
+  }
+  if (next.size() < 3)
+    return Solid();
+  std::vector<double> xs, ys;
+  int vtx = next.begin()->first;
+  do {
+    xs.push_back(tess.vertex(vtx)[0]);
+    ys.push_back(tess.vertex(vtx)[1]);
+    auto it = next.find(vtx);
+    if (it == next.end() || xs.size() > next.size())
+      return Solid();
+    vtx = it->second;
+  } while (vtx != next.begin()->first);
+  if (xs.size() != next.size())
+    return Solid();
+
+  double area = 0.0;
+  for (size_t i = 0; i < xs.size(); i++) {
+    size_t j = (i + 1) % xs.size();
+    area += 0.5 * (xs[i] * ys[j] - xs[j] * ys[i]);
+  }
+  if (std::abs(std::abs(area) * (zmax - zmin) - mesh_volume) > 1e-6 * mesh_volume)
+    return Solid();
+
+  return ExtrudedPolygon(xs, ys, {zmin, zmax}, {0.0, 0.0}, {0.0, 0.0}, {1.0, 1.0});
+}
+
 static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector sens) {
 
   // printout(WARNING, "BarrelHCalCalorimeter", "called create_detector ");
@@ -176,8 +279,36 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
 
   // Read in the barrel structure GDML file
   // three structures - normal sector, chimney sector, and end rings
+  // Closed tessellated meshes are cached next to the downloaded GDML files
   Assembly BarrelHCAL("BarrelHCAL");
   TGDMLParse parser;
+  bool importCache = getAttrOrDefault<bool>(x_det, _Unicode(importCache), true);
+
+  // The steel can be replaced by equivalent extruded polygons, which are much cheaper to
+  // navigate than the meshes. Meshes that are not right prisms along z stay tessellated.
+  std::string steelShape =
+      getAttrOrDefault<std::string>(x_det, _Unicode(steelShape), "tessellated");
+  if (steelShape != "tessellated" && steelShape != "extruded") {
+    printout(ERROR, "BarrelHCalCalorimeter", "unknown steelShape " + steelShape);
+    std::_Exit(EXIT_FAILURE);
+  }
+  auto simplifySteel = [&](Volume vol) {
+    if (steelShape != "extruded")
+      return;
+    TessellatedSolid tess = vol.solid();
+    double mesh_volume    = 0.0;
+    Solid extruded        = extrude_prism(tess, mesh_volume);
+    if (!extruded.isValid()) {
+      printout(WARNING, "BarrelHCalCalorimeter",
+               "%s is not a right prism along z, kept tessellated", vol.name());
+      return;
+    }
+    // same material, so equal volumes also mean equal masses
+    printout(INFO, "BarrelHCalCalorimeter",
+             "%s: %d facets replaced by extruded polygon, volume %.6g -> %.6g cm3", vol.name(),
+             tess.num_facet(), mesh_volume / dd4hep::cm3, extruded->Capacity() / dd4hep::cm3);
+    vol.setSolid(extruded);
+  };
 
   // sector
   EnsureFileFromURLExists(sec_gdml_url, sec_gdml_file, sec_gdml_cache);
@@ -188,18 +319,16 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
     std::_Exit(EXIT_FAILURE);
   }
 
-  Volume barrel_sector_vol = parser.GDMLReadFile(sec_gdml_file.c_str());
+  Material sector_material = description.material(sec_gdml_material.c_str());
+  Volume barrel_sector_vol =
+      ImportTessellatedGDML(parser, sec_gdml_file, sector_material, importCache);
   if (!barrel_sector_vol.isValid()) {
     printout(WARNING, "BarrelHCalCalorimeter", "%s", sec_gdml_file.c_str());
     printout(WARNING, "BarrelHCalCalorimeter", "barrel_sector_vol invalid, GDML parser failed!");
     std::_Exit(EXIT_FAILURE);
   }
-  barrel_sector_vol.import();
   barrel_sector_vol.setVisAttributes(description, x_det.visStr());
-  TessellatedSolid barrel_sector_solid = barrel_sector_vol.solid();
-  barrel_sector_solid->CloseShape(true, true, true); // tesselated solid not closed by import!
-  Material sector_material = description.material(sec_gdml_material.c_str());
-  barrel_sector_vol.setMaterial(sector_material);
+  simplifySteel(barrel_sector_vol);
 
   // chimney sector
   EnsureFileFromURLExists(csec_gdml_url, csec_gdml_file, csec_gdml_cache);
@@ -210,18 +339,16 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
     std::_Exit(EXIT_FAILURE);
   }
 
-  Volume barrel_csector_vol = parser.GDMLReadFile(csec_gdml_file.c_str());
+  Material csector_material = description.material(csec_gdml_material.c_str());
+  Volume barrel_csector_vol =
+      ImportTessellatedGDML(parser, csec_gdml_file, csector_material, importCache);
   if (!barrel_csector_vol.isValid()) {
     printout(WARNING, "BarrelHCalCalorimeter", "%s", csec_gdml_file.c_str());
     printout(WARNING, "BarrelHCalCalorimeter", "barrel_csector_vol invalid, GDML parser failed!");
     std::_Exit(EXIT_FAILURE);
   }
-  barrel_csector_vol.import();
   barrel_csector_vol.setVisAttributes(description, x_det.visStr());
-  TessellatedSolid barrel_csector_solid = barrel_csector_vol.solid();
-  barrel_csector_solid->CloseShape(true, true, true); // tesselated solid not closed by import!
-  Material csector_material = description.material(csec_gdml_material.c_str());
-  barrel_csector_vol.setMaterial(csector_material);
+  simplifySteel(barrel_csector_vol);
 
   // end ring
   EnsureFileFromURLExists(er_gdml_url, er_gdml_file, er_gdml_cache);
@@ -232,18 +359,15 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
     std::_Exit(EXIT_FAILURE);
   }
 
-  Volume barrel_er_vol = parser.GDMLReadFile(er_gdml_file.c_str());
+  Material er_material   = description.material(er_gdml_material.c_str());
+  Volume barrel_er_vol   = ImportTessellatedGDML(parser, er_gdml_file, er_material, importCache);
   if (!barrel_er_vol.isValid()) {
     printout(WARNING, "BarrelHCalCalorimeter", "%s", er_gdml_file.c_str());
     printout(WARNING, "BarrelHCalCalorimeter", "barrel_er_vol invalid, GDML parser failed!");
     std::_Exit(EXIT_FAILURE);
   }
-  barrel_er_vol.import();
   barrel_er_vol.setVisAttributes(description, x_det.visStr());
-  TessellatedSolid barrel_er_solid = barrel_er_vol.solid();
-  barrel_er_solid->CloseShape(true, true, true); // tesselated solid not closed by import!
-  Material er_material = description.material(er_gdml_material.c_str());
-  barrel_er_vol.setMaterial(er_material);
+  simplifySteel(barrel_er_vol);
 
   // Place steel in envelope
 
@@ -313,18 +437,14 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
       std::_Exit(EXIT_FAILURE);
     }
 
-    Volume solidVolume = parser.GDMLReadFile(tgdml_file.c_str());
+    Material tile_material = description.material(tgdml_material.c_str());
+    Volume solidVolume     = ImportTessellatedGDML(parser, tgdml_file, tile_material, importCache);
     if (!solidVolume.isValid()) {
       printout(WARNING, "BarrelHCalCalorimeter_geo", "%s", tgdml_file.c_str());
       printout(WARNING, "BarrelHCalCalorimeter_geo", "solidVolume invalid, GDML parser failed!");
       std::_Exit(EXIT_FAILURE);
     }
-    solidVolume.import();
     solidVolume.setVisAttributes(description, x_det.visStr());
-    TessellatedSolid volume_solid = solidVolume.solid();
-    volume_solid->CloseShape(true, true, true); // tesselated solid not closed by import!
-    Material tile_material = description.material(tgdml_material.c_str());
-    solidVolume.setMaterial(tile_material);
 
     solidVolume.setSensitiveDetector(sens);
 
@@ -363,9 +483,35 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
   double increment_angle  = (360.0 / 320.0) * dd4hep::deg;
   double increment_offset = -10.01 * increment_angle;
 
-  DetElement tile_det("eta0 phi0", det_id);
   sens.setType("calorimeter");
 
+  // Per-tile DetElements are optional; the (eta, phi) tile table is always attached
+  bool tileDetElements = getAttrOrDefault<bool>(x_det, _Unicode(tileDetElements), true);
+  IDDescriptor id_spec = sens.readout().idSpec();
+  auto* tileTable      = new epic::hcal::TileTable();
+  tileTable->resize(24, 320);
+  tileTable->etaOffset = id_spec.field("eta")->offset();
+  tileTable->etaWidth  = id_spec.field("eta")->width();
+  tileTable->phiOffset = id_spec.field("phi")->offset();
+  tileTable->phiWidth  = id_spec.field("phi")->width();
+
+  auto addTile = [&](PlacedVolume phv, int eta, int phi) {
+    phv.addPhysVolID("eta", eta).addPhysVolID("phi", phi);
+    // BarrelHCAL is placed unrotated at the envelope origin
+    const TGeoMatrix* mat = phv->GetMatrix();
+    epic::hcal::Tile tile;
+    tile.eta = eta;
+    tile.phi = phi;
+    std::copy(mat->GetTranslation(), mat->GetTranslation() + 3, tile.pos.begin());
+    std::copy(mat->GetRotationMatrix(), mat->GetRotationMatrix() + 9, tile.rot.begin());
+    tileTable->set(tile);
+    if (tileDetElements) {
+      DetElement sd(_toString(eta, "eta%d ") + _toString(phi, "phi%d"), det_id);
+      sd.setPlacement(phv);
+      sdet.add(sd);
+    }
+  };
+
   for (int i_eta = 0; i_eta < 12; i_eta++) { // eta ring
 
     int tnum = 11 - i_eta;
@@ -388,10 +534,7 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
                     Translation3D(-(xposTile[tnum] + (tnum + 1) * tile_tolerance) * dd4hep::mm,
                                   yposTile[tnum] * dd4hep::mm, -zposTile[tnum] * dd4hep::mm)));
 
-        phv1.addPhysVolID("eta", i_eta).addPhysVolID("phi", i_phi);
-        DetElement sd1 = tile_det.clone(_toString(i_eta, "eta%d ") + _toString(i_phi, "phi%d"));
-        sd1.setPlacement(phv1);
-        sdet.add(sd1);
+        addTile(phv1, i_eta, i_phi);
 
         PlacedVolume phv0 = BarrelHCAL.placeVolume(
             Tile[i_eta], i_phi + (12 + tnum) * 320,
@@ -403,11 +546,7 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
                 Translation3D((xposTile[tnum] + (tnum + 1) * tile_tolerance) * dd4hep::mm,
                               yposTile[tnum] * dd4hep::mm, zposTile[tnum] * dd4hep::mm));
 
-        phv0.addPhysVolID("eta", (12 + tnum)).addPhysVolID("phi", i_phi);
-        DetElement sd0 =
-            tile_det.clone(_toString((12 + tnum), "eta%d ") + _toString(i_phi, "phi%d"));
-        sd0.setPlacement(phv0);
-        sdet.add(sd0);
+        addTile(phv0, 12 + tnum, i_phi);
 
       } else {
 
@@ -427,10 +566,7 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
                   Translation3D((xposTile[tnum] + (tnum + 1) * tile_tolerance) * dd4hep::mm,
                                 yposTile[tnum] * dd4hep::mm, zposTile[tnum] * dd4hep::mm));
 
-          phv1.addPhysVolID("eta", i_eta).addPhysVolID("phi", i_phi);
-          DetElement sd1 = tile_det.clone(_toString(i_eta, "eta%d ") + _toString(i_phi, "phi%d"));
-          sd1.setPlacement(phv1);
-          sdet.add(sd1);
+          addTile(phv1, i_eta, i_phi);
 
           PlacedVolume phv0 = BarrelHCAL.placeVolume(
               Tile[i_eta], i_phi + (12 + tnum) * 320,
@@ -444,11 +580,7 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
                       Translation3D(-(xposTile[tnum] + (tnum + 1) * tile_tolerance) * dd4hep::mm,
                                     yposTile[tnum] * dd4hep::mm, -zposTile[tnum] * dd4hep::mm)));
 
-          phv0.addPhysVolID("eta", (12 + tnum)).addPhysVolID("phi", i_phi);
-          DetElement sd0 =
-              tile_det.clone(_toString((12 + tnum), "eta%d ") + _toString(i_phi, "phi%d"));
-          sd0.setPlacement(phv0);
-          sdet.add(sd0);
+          addTile(phv0, 12 + tnum, i_phi);
 
         } else {
 
@@ -466,11 +598,7 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
                                 yposChimneyTileS[tnum - 8] * dd4hep::mm,
                                 zposChimneyTileS[tnum - 8] * dd4hep::mm));
 
-          phv1.addPhysVolID("eta", (12 + tnum)).addPhysVolID("phi", i_phi);
-          DetElement sd1 =
-              tile_det.clone(_toString((12 + tnum), "eta%d ") + _toString(i_phi, "phi%d"));
-          sd1.setPlacement(phv1);
-          sdet.add(sd1);
+          addTile(phv1, 12 + tnum, i_phi);
 
           PlacedVolume phv0 = BarrelHCAL.placeVolume(
               Tile[i_eta], i_phi + i_eta * 320,
@@ -482,10 +610,7 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
                   Translation3D((xposTile[tnum] + (tnum + 1) * tile_tolerance) * dd4hep::mm,
                                 yposTile[tnum] * dd4hep::mm, zposTile[tnum] * dd4hep::mm));
 
-          phv0.addPhysVolID("eta", i_eta).addPhysVolID("phi", i_phi);
-          DetElement sd0 = tile_det.clone(_toString(i_eta, "eta%d ") + _toString(i_phi, "phi%d"));
-          sd0.setPlacement(phv0);
-          sdet.add(sd0);
+          addTile(phv0, i_eta, i_phi);
         }
       }
     }
@@ -494,6 +619,7 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
   // Place the detector into the envelope
 
   envelope.placeVolume(BarrelHCAL, 0, Transform3D(RotationZ(0.0), Translation3D(0, 0, 0)));
+  sdet.addExtension<epic::hcal::TileTable>(tileTable);
 
   std::string env_vis =
       getAttrOrDefault<std::string>(x_det, _Unicode(env_vis), "HcalBarrelEnvelopeVis");
@@ -501,4 +627,4 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
   return sdet;
 }
 
-DECLARE_DETELEMENT(epic_HcalBarrelGDML, create_detector)
+DECLARE_PROFILED_DETELEMENT(epic_HcalBarrelGDML, create_detector)
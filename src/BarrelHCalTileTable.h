@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 ePIC Collaboration
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Flat table of barrel HCal tile placements
+//
+// The barrel HCal builder attaches one `TileTable` extension to the barrel HCal DetElement.
+// It has one entry per (eta, phi) tile, indexed by `eta * nPhi + phi`. Each entry holds the
+// tile transform in the frame of the barrel HCal envelope. This replaces one DetElement per
+// tile. A hit's tile is found by decoding the eta and phi fields of its cellID:
+//
+//   auto* table = det.extension<epic::hcal::TileTable>();
+//   if (const auto* tile = table->find(hit.cellID)) { ... tile->pos ... }
+namespace epic::hcal {
+
+struct Tile {
+  int eta = -1;                // eta index, -1 if no tile is placed
+  int phi = -1;                // phi index
+  std::array<double, 3> pos{}; // tile origin (envelope frame)
+  std::array<double, 9> rot{}; // tile rotation matrix, row major
+};
+
+class TileTable {
+public:
+  int nEta = 0;
+  int nPhi = 0;
+
+  // cellID bit fields of eta and phi
+  int etaOffset = 0;
+  int etaWidth  = 0;
+  int phiOffset = 0;
+  int phiWidth  = 0;
+
+  std::vector<Tile> tiles; // indexed by eta * nPhi + phi
+
+  void resize(int n_eta, int n_phi) {
+    nEta = n_eta;
+    nPhi = n_phi;
+    tiles.assign(static_cast<std::size_t>(nEta) * nPhi, Tile{});
+  }
+
+  void set(const Tile& tile) {
+    tiles[static_cast<std::size_t>(tile.eta) * nPhi + tile.phi] = tile;
+  }
+
+  // tile at (eta, phi), or nullptr
+  const Tile* find(int eta, int phi) const {
+    if (eta < 0 || eta >= nEta || phi < 0 || phi >= nPhi) {
+      return nullptr;
+    }
+    const Tile& tile = tiles[static_cast<std::size_t>(eta) * nPhi + phi];
+    return tile.eta < 0 ? nullptr : &tile;
+  }
+
+  // tile containing this cellID, or nullptr
+  const Tile* find(std::uint64_t cellID) const {
+    return find(static_cast<int>((cellID >> etaOffset) & ((1ULL << etaWidth) - 1)),
+                static_cast<int>((cellID >> phiOffset) & ((1ULL << phiWidth) - 1)));
+  }
+};
+
+} // namespace epic::hcal
@@ -25,6 +25,7 @@
 #include "XML/Layering.h"
 #include "XML/Utilities.h"
 #include <array>
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -331,4 +332,4 @@ static Ref_t create_BarrelPlanarMPGDTracker_geo(Detector& description, xml_h e,
 
 //@}
 // clang-format off
-DECLARE_DETELEMENT(epic_OuterMPGDBarrel, create_BarrelPlanarMPGDTracker_geo)
+DECLARE_PROFILED_DETELEMENT(epic_OuterMPGDBarrel, create_BarrelPlanarMPGDTracker_geo)
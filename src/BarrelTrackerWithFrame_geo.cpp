@@ -16,8 +16,9 @@
 #include "DDRec/Surface.h"
 #include "XML/Layering.h"
 #include "XML/Utilities.h"
-#include <array>
 #include "DD4hepDetectorHelper.h"
+#include "TrackerModuleBuilder.h"
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -45,17 +46,13 @@ using namespace dd4hep::detail;
  * @author Whitney Armstrong
  */
 static Ref_t create_BarrelTrackerWithFrame(Detector& description, xml_h e, SensitiveDetector sens) {
-  typedef vector<PlacedVolume> Placements;
   xml_det_t x_det = e;
   Material air    = description.air();
   int det_id      = x_det.id();
   string det_name = x_det.nameStr();
   DetElement sdet(det_name, det_id);
 
-  map<string, Volume> volumes;
-  map<string, Placements> sensitives;
-  map<string, std::vector<VolPlane>> volplane_surfaces;
-  map<string, std::array<double, 2>> module_thicknesses;
+  map<string, epic::tracker::ModuleType> module_types;
 
   PlacedVolume pv;
 
@@ -121,24 +118,21 @@ static Ref_t create_BarrelTrackerWithFrame(Detector& description, xml_h e, Sensi
     xml_comp_t x_mod = mi;
     string m_nam     = x_mod.nameStr();
 
-    if (volumes.find(m_nam) != volumes.end()) {
+    if (module_types.find(m_nam) != module_types.end()) {
       printout(ERROR, "BarrelTrackerWithFrame",
                string((string("Module with named ") + m_nam + string(" already exists."))).c_str());
       throw runtime_error("Logics error in building modules.");
     }
 
-    int ncomponents        = 0;
-    int sensor_number      = 1;
-    double total_thickness = 0;
+    int ncomponents                     = 0;
+    int sensor_number                   = 1;
+    epic::tracker::ModuleStack stack    = epic::tracker::stackComponents(x_mod, true);
+    double total_thickness              = stack.total_thickness;
+    epic::tracker::ModuleType& mod_type = module_types[m_nam];
 
-    // Compute module total thickness from components
-    xml_coll_t ci(x_mod, _U(module_component));
-    for (ci.reset(), total_thickness = 0.0; ci; ++ci) {
-      total_thickness += xml_comp_t(ci).thickness();
-    }
     // the module assembly volume
     Assembly m_vol(m_nam);
-    volumes[m_nam] = m_vol;
+    mod_type.volume = m_vol;
     m_vol.setVisAttributes(description.visAttributes(x_mod.visStr()));
 
     // Optional module frame.
@@ -166,30 +160,24 @@ static Ref_t create_BarrelTrackerWithFrame(Detector& description, xml_h e, Sensi
                         Position(0.0, 0.0, frame_height / 2 + total_thickness / 2.0));
     }
 
-    double thickness_so_far = 0.0;
-    double thickness_sum    = -total_thickness / 2.0;
-    for (xml_coll_t mci(x_mod, _U(module_component)); mci; ++mci, ++ncomponents) {
-      xml_comp_t x_comp  = mci;
+    for (auto& comp : stack.components) {
+      xml_comp_t x_comp  = comp.x_comp;
       xml_comp_t x_pos   = x_comp.position(false);
       xml_comp_t x_rot   = x_comp.rotation(false);
-      const string c_nam = _toString(ncomponents, "component%d");
+      const string c_nam = _toString(ncomponents++, "component%d");
       Box c_box(x_comp.width() / 2, x_comp.length() / 2, x_comp.thickness() / 2);
       Volume c_vol(c_nam, c_box, description.material(x_comp.materialStr()));
 
-      // Utility variable for the relative z-offset based off the previous components
-      const double zoff = thickness_sum + x_comp.thickness() / 2.0;
-      if (x_pos && x_rot) {
-        Position c_pos(x_pos.x(0), x_pos.y(0), x_pos.z(0) + zoff);
-        RotationZYX c_rot(x_rot.z(0), x_rot.y(0), x_rot.x(0));
-        pv = m_vol.placeVolume(c_vol, Transform3D(c_rot, c_pos));
-      } else if (x_rot) {
-        Position c_pos(0, 0, zoff);
+      // the stack includes the relative z-offsets of the components
+      Position c_pos(0, 0, comp.center);
+      if (x_pos) {
+        c_pos = Position(x_pos.x(0), x_pos.y(0), comp.center);
+      }
+      if (x_rot) {
         pv = m_vol.placeVolume(c_vol,
                                Transform3D(RotationZYX(x_rot.z(0), x_rot.y(0), x_rot.x(0)), c_pos));
-      } else if (x_pos) {
-        pv = m_vol.placeVolume(c_vol, Position(x_pos.x(0), x_pos.y(0), x_pos.z(0) + zoff));
       } else {
-        pv = m_vol.placeVolume(c_vol, Position(0, 0, zoff));
+        pv = m_vol.placeVolume(c_vol, c_pos);
       }
       c_vol.setRegion(description, x_comp.regionStr());
       c_vol.setLimitSet(description, x_comp.limitsStr());
@@ -197,9 +185,7 @@ static Ref_t create_BarrelTrackerWithFrame(Detector& description, xml_h e, Sensi
       if (x_comp.isSensitive()) {
         pv.addPhysVolID("sensor", sensor_number++);
         c_vol.setSensitiveDetector(sens);
-        sensitives[m_nam].push_back(pv);
-        module_thicknesses[m_nam] = {thickness_so_far + x_comp.thickness() / 2.0,
-                                     total_thickness - thickness_so_far - x_comp.thickness() / 2.0};
+        mod_type.sensors.push_back(pv);
 
         // -------- create a measurement plane for the tracking surface attched to the sensitive volume -----
         Vector3D u(-1., 0., 0.);
@@ -207,32 +193,23 @@ static Ref_t create_BarrelTrackerWithFrame(Detector& description, xml_h e, Sensi
         Vector3D n(0., 0., 1.);
         //    Vector3D o( 0. , 0. , 0. ) ;
 
-        // compute the inner and outer thicknesses that need to be assigned to the tracking surface
-        // depending on wether the support is above or below the sensor
-        double inner_thickness = module_thicknesses[m_nam][0];
-        double outer_thickness = module_thicknesses[m_nam][1];
-
+        // the inner and outer thicknesses that need to be assigned to the tracking surface
+        // depend on wether the support is above or below the sensor
         SurfaceType type(SurfaceType::Sensitive);
 
         // if( isStripDetector )
         //  type.setProperty( SurfaceType::Measurement1D , true ) ;
 
-        VolPlane surf(c_vol, type, inner_thickness, outer_thickness, u, v, n); //,o ) ;
-        volplane_surfaces[m_nam].push_back(surf);
+        VolPlane surf(c_vol, type, comp.inner_thickness, comp.outer_thickness, u, v, n); //,o ) ;
+        mod_type.descriptors.emplace_back("XYZ", surf);
 
         //--------------------------------------------
       }
-      thickness_sum += x_comp.thickness();
-      thickness_so_far += x_comp.thickness();
-      // apply relative offsets in z-position used to stack components side-by-side
-      if (x_pos) {
-        thickness_sum += x_pos.z(0);
-        thickness_so_far += x_pos.z(0);
-      }
     }
   }
 
-  // now build the layers
+  // now build the layers, layers with the same layout share one placement plan
+  epic::tracker::PlacementCache<epic::tracker::StaveLayout> stave_plans;
   for (xml_coll_t li(x_det, _U(layer)); li; ++li) {
     xml_comp_t x_layer  = li;
     xml_comp_t x_barrel = x_layer.child(_U(barrel_envelope));
@@ -246,20 +223,8 @@ static Ref_t create_BarrelTrackerWithFrame(Detector& description, xml_h e, Sensi
     Position lay_pos(0, 0, getAttrOrDefault(x_barrel, _U(z0), 0.));
     lay_vol.setVisAttributes(description.visAttributes(x_layer.visStr()));
 
-    double phi0     = x_layout.phi0();     // Starting phi of first module.
-    double phi_tilt = x_layout.phi_tilt(); // Phi tilt of a module.
-    double rc       = x_layout.rc();       // Radius of the module center.
-    int nphi        = x_layout.nphi();     // Number of modules in phi.
-    double rphi_dr  = x_layout.dr();       // The delta radius of every other module.
-    double phi_incr = (M_PI * 2) / nphi;   // Phi increment for one module.
-    double phic     = phi0;                // Phi of the module center.
-    double z0       = z_layout.z0();       // Z position of first module in phi.
-    double nz       = z_layout.nz();       // Number of modules to place in z.
-    double z_dr     = z_layout.dr();       // Radial displacement parameter, of every other module.
-
-    Volume module_env = volumes[m_nam];
+    const epic::tracker::ModuleType& mod_type = module_types[m_nam];
     DetElement lay_elt(sdet, lay_nam, lay_id);
-    Placements& sensVols = sensitives[m_nam];
 
     // the local coordinate systems of modules in dd4hep and acts differ
     // see http://acts.web.cern.ch/ACTS/latest/doc/group__DD4hepPlugins.html
@@ -272,62 +237,18 @@ static Ref_t create_BarrelTrackerWithFrame(Detector& description, xml_h e, Sensi
                                                       "layer_material");
     }
 
-    // Z increment for module placement along Z axis.
-    // Adjust for z0 at center of module rather than
-    // the end of cylindrical envelope.
-    double z_incr = nz > 1 ? (2.0 * z0) / (nz - 1) : 0.0;
-    // Starting z for module placement along Z axis.
-    double module_z = -z0;
-    int module      = 1;
-
-    // Loop over the number of modules in phi.
-    for (int ii = 0; ii < nphi; ii++) {
-      double dx = z_dr * std::cos(phic + phi_tilt); // Delta x of module position.
-      double dy = z_dr * std::sin(phic + phi_tilt); // Delta y of module position.
-      double x  = rc * std::cos(phic);              // Basic x module position.
-      double y  = rc * std::sin(phic);              // Basic y module position.
-
-      // Loop over the number of modules in z.
-      for (int j = 0; j < nz; j++) {
-        string module_name = _toString(module, "module%d");
-        DetElement mod_elt(lay_elt, module_name, module);
-
-        Transform3D tr(RotationZYX(0, ((M_PI / 2) - phic - phi_tilt), -M_PI / 2),
-                       Position(x, y, module_z));
-
-        pv = lay_vol.placeVolume(module_env, tr);
-        pv.addPhysVolID("module", module);
-        mod_elt.setPlacement(pv);
-        for (size_t ic = 0; ic < sensVols.size(); ++ic) {
-          PlacedVolume sens_pv = sensVols[ic];
-          DetElement comp_de(mod_elt, std::string("de_") + sens_pv.volume().name(), module);
-          comp_de.setPlacement(sens_pv);
-
-          auto& comp_de_params =
-              DD4hepDetectorHelper::ensureExtension<dd4hep::rec::VariantParameters>(comp_de);
-          comp_de_params.set<string>("axis_definitions", "XYZ");
-          // comp_de.setAttributes(description, sens_pv.volume(), x_layer.regionStr(), x_layer.limitsStr(),
-          //                       xml_det_t(xmleles[m_nam]).visStr());
-          //
-
-          volSurfaceList(comp_de)->push_back(volplane_surfaces[m_nam][ic]);
-        }
-
-        /// Increase counters etc.
-        module++;
-        // Adjust the x and y coordinates of the module.
-        x += dx;
-        y += dy;
-        // Flip sign of x and y adjustments.
-        dx *= -1;
-        dy *= -1;
-        // Add z increment to get next z placement pos.
-        module_z += z_incr;
-      }
-      phic += phi_incr; // Increment the phi placement of module.
-      rc += rphi_dr;    // Increment the center radius according to dr parameter.
-      rphi_dr *= -1;    // Flip sign of dr parameter.
-      module_z = -z0;   // Reset the Z placement parameter for module.
+    // nphi staves of nz modules, numbered from 1 in phi-major order
+    const auto& plan = stave_plans.plan(epic::tracker::StaveLayout::fromXml(x_layout, z_layout));
+    for (size_t im = 0; im < plan.size(); ++im) {
+      int module         = im + 1;
+      string module_name = _toString(module, "module%d");
+      DetElement mod_elt(lay_elt, module_name, module);
+
+      pv = lay_vol.placeVolume(mod_type.volume, plan[im]);
+      pv.addPhysVolID("module", module);
+      mod_elt.setPlacement(pv);
+      // parameters and surfaces are shared by all sensors of the module type
+      epic::tracker::addSensorElements(mod_elt, mod_type, "de_", module);
     }
     // Create the PhysicalVolume for the layer.
     pv = assembly.placeVolume(lay_vol, lay_pos); // Place layer in mother
@@ -346,8 +267,8 @@ static Ref_t create_BarrelTrackerWithFrame(Detector& description, xml_h e, Sensi
 
 //@}
 // clang-format off
-DECLARE_DETELEMENT(epic_BarrelTrackerWithFrame, create_BarrelTrackerWithFrame)
-DECLARE_DETELEMENT(epic_TrackerBarrel,   create_BarrelTrackerWithFrame)
-DECLARE_DETELEMENT(epic_VertexBarrel,    create_BarrelTrackerWithFrame)
-DECLARE_DETELEMENT(epic_TOFBarrel,       create_BarrelTrackerWithFrame)
-DECLARE_DETELEMENT(epic_InnerMPGDBarrel,       create_BarrelTrackerWithFrame)
+DECLARE_PROFILED_DETELEMENT(epic_BarrelTrackerWithFrame, create_BarrelTrackerWithFrame)
+DECLARE_PROFILED_DETELEMENT(epic_TrackerBarrel,   create_BarrelTrackerWithFrame)
+DECLARE_PROFILED_DETELEMENT(epic_VertexBarrel,    create_BarrelTrackerWithFrame)
+DECLARE_PROFILED_DETELEMENT(epic_TOFBarrel,       create_BarrelTrackerWithFrame)
+DECLARE_PROFILED_DETELEMENT(epic_InnerMPGDBarrel,       create_BarrelTrackerWithFrame)
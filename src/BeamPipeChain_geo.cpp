@@ -14,6 +14,7 @@
 #include "DD4hep/Printout.h"
 #include "TMath.h"
 #include <XML/Helper.h>
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -123,4 +124,4 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector /
   return sdet;
 }
 
-DECLARE_DETELEMENT(BeamPipeChain, create_detector)
+DECLARE_PROFILED_DETELEMENT(BeamPipeChain, create_detector)
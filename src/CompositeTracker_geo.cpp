@@ -14,6 +14,7 @@
 #include "DD4hep/Printout.h"
 #include "XML/Utilities.h"
 #include "DD4hepDetectorHelper.h"
+#include "ConstructionProfiler.h"
 
 using namespace dd4hep;
 using namespace dd4hep::detail;
@@ -60,4 +61,4 @@ static Ref_t create_element(Detector& description, xml_h e, Ref_t) {
   return sdet;
 }
 
-DECLARE_DETELEMENT(epic_CompositeTracker, create_element)
+DECLARE_PROFILED_DETELEMENT(epic_CompositeTracker, create_element)
@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 ePIC Collaboration
+
+#include <DD4hep/DetFactoryHelper.h>
+#include <DD4hep/Factories.h>
+#include <DD4hep/Printout.h>
+
+#include <TGeoManager.h>
+#include <TGeoVolume.h>
+#include <TObjArray.h>
+
+#include <fmt/core.h>
+
+#include <sys/resource.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "ConstructionProfiler.h"
+
+using namespace dd4hep;
+
+namespace epic::profiling {
+
+namespace {
+
+  // user + system CPU time and peak RSS (in kB on Linux) of this process
+  void resource_usage(double& cpu_ms, long& peak_rss_kb) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    cpu_ms = 1e3 * (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+             1e-3 * (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+    peak_rss_kb = usage.ru_maxrss;
+  }
+
+  std::string json_escape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+      if (c == '"' || c == '\\') {
+        out += '\\';
+      }
+      out += c;
+    }
+    return out;
+  }
+
+} // namespace
+
+ConstructionProfiler& ConstructionProfiler::instance() {
+  static ConstructionProfiler profiler;
+  return profiler;
+}
+
+bool ConstructionProfiler::write(const std::string& path) const {
+  std::ofstream out(path);
+  if (!out) {
+    return false;
+  }
+  const bool csv = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+  if (csv) {
+    out << "name,type,wall_ms,cpu_ms,peak_rss_delta_kb,volumes,nodes,shapes\n";
+    for (const auto& r : m_records) {
+      out << fmt::format("{},{},{:.3f},{:.3f},{},{},{},{}\n", r.name, r.type, r.wall_ms, r.cpu_ms,
+                         r.peak_rss_delta_kb, r.volumes, r.nodes, r.shapes);
+    }
+  } else {
+    out << "[\n";
+    for (std::size_t i = 0; i < m_records.size(); ++i) {
+      const auto& r = m_records[i];
+      out << fmt::format("  {{\"name\": \"{}\", \"type\": \"{}\", \"wall_ms\": {:.3f}, "
+                         "\"cpu_ms\": {:.3f}, \"peak_rss_delta_kb\": {}, \"volumes\": {}, "
+                         "\"nodes\": {}, \"shapes\": {}}}{}\n",
+                         json_escape(r.name), json_escape(r.type), r.wall_ms, r.cpu_ms,
+                         r.peak_rss_delta_kb, r.volumes, r.nodes, r.shapes,
+                         i + 1 < m_records.size() ? "," : "");
+    }
+    out << "]\n";
+  }
+  return out.good();
+}
+
+ConstructionProfiler::~ConstructionProfiler() {
+  // only plain iostreams here, this runs during static destruction
+  const char* path = std::getenv("EPIC_CONSTRUCTION_PROFILE");
+  if (path != nullptr && std::strlen(path) > 0 && !m_records.empty()) {
+    if (!write(path)) {
+      std::cerr << "ConstructionProfiler: unable to write " << path << std::endl;
+    }
+  }
+}
+
+ConstructionScope::ConstructionScope(Detector& desc, const char* type, const xml::Handle_t& e)
+    : m_desc(desc), m_wall_start(std::chrono::steady_clock::now()) {
+  xml_comp_t x_elem(e);
+  m_record.name = x_elem.hasAttr(_U(name)) ? x_elem.nameStr() : std::string();
+  m_record.type = type;
+
+  TGeoManager& mgr    = m_desc.manager();
+  m_volumes_start     = mgr.GetListOfVolumes()->GetEntriesFast();
+  m_shapes_start      = mgr.GetListOfShapes()->GetEntriesFast();
+  m_world_nodes_start = m_desc.worldVolume()->GetNdaughters();
+  resource_usage(m_cpu_start_ms, m_peak_rss_start_kb);
+}
+
+ConstructionScope::~ConstructionScope() {
+  double cpu_ms;
+  long peak_rss_kb;
+  resource_usage(cpu_ms, peak_rss_kb);
+  m_record.wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                                               m_wall_start)
+                         .count();
+  m_record.cpu_ms            = cpu_ms - m_cpu_start_ms;
+  m_record.peak_rss_delta_kb = peak_rss_kb - m_peak_rss_start_kb;
+
+  TGeoManager& mgr   = m_desc.manager();
+  TObjArray* volumes = mgr.GetListOfVolumes();
+  m_record.volumes   = volumes->GetEntriesFast() - m_volumes_start;
+  m_record.shapes    = mgr.GetListOfShapes()->GetEntriesFast() - m_shapes_start;
+  m_record.nodes     = m_desc.worldVolume()->GetNdaughters() - m_world_nodes_start;
+  for (long i = m_volumes_start; i < volumes->GetEntriesFast(); ++i) {
+    auto* vol = static_cast<TGeoVolume*>(volumes->At(i));
+    if (vol != nullptr) {
+      m_record.nodes += vol->GetNdaughters();
+    }
+  }
+
+  printout(DEBUG, "ConstructionProfiler",
+           "%s (%s): wall %.1f ms, cpu %.1f ms, peak rss +%ld kB, %ld volumes, %ld nodes, "
+           "%ld shapes",
+           m_record.name.c_str(), m_record.type.c_str(), m_record.wall_ms, m_record.cpu_ms,
+           m_record.peak_rss_delta_kb, m_record.volumes, m_record.nodes, m_record.shapes);
+  ConstructionProfiler::instance().add(std::move(m_record));
+}
+
+} // namespace epic::profiling
+
+static void usage_construction_profile(int argc, char** argv) {
+  std::cerr
+      << "Usage: -plugin <name> -arg [-arg]                                                  \n"
+         "     output:<string>          report file, .csv or .json                           \n"
+         "\tArguments given: "
+      << arguments(argc, argv) << std::endl;
+  std::exit(EINVAL);
+}
+
+// Plugin to print and write the construction profile of all detectors built so far
+static long construction_profile(Detector& /* desc */, int argc, char** argv) {
+  std::string output;
+  for (int i = 0; i < argc && argv[i]; ++i) {
+    if (0 == std::strncmp("output:", argv[i], 7))
+      output = (argv[i] + 7);
+    else {
+      std::cerr << "Unexpected argument \"" << argv[i] << "\"" << std::endl;
+      usage_construction_profile(argc, argv);
+    }
+  }
+
+  const auto& profiler = epic::profiling::ConstructionProfiler::instance();
+  for (const auto& r : profiler.records()) {
+    printout(INFO, "ConstructionProfiler",
+             "%-32s %-40s wall %9.1f ms  cpu %9.1f ms  rss +%8ld kB  %7ld vol  %8ld nodes",
+             r.name.c_str(), r.type.c_str(), r.wall_ms, r.cpu_ms, r.peak_rss_delta_kb, r.volumes,
+             r.nodes);
+  }
+  if (!output.empty() && !profiler.write(output)) {
+    printout(ERROR, "ConstructionProfiler", "unable to write " + output);
+    return 0;
+  }
+  return 1;
+}
+
+DECLARE_APPLY(epic_ConstructionProfile, construction_profile)
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 ePIC Collaboration
+
+//==========================================================================
+//  Per-detector construction profiler
+//
+//  Every factory declared with DECLARE_PROFILED_DETELEMENT (or
+//  DECLARE_PROFILED_XMLELEMENT for fields) is wrapped in a scope that
+//  records wall time, CPU time, peak RSS growth and the number of TGeo
+//  volumes, nodes and shapes created while it ran.
+//
+//  The report is written at exit when EPIC_CONSTRUCTION_PROFILE is set to
+//  a file name ending in .json or .csv, or on demand with the plugin
+//    -plugin epic_ConstructionProfile output:<file>
+//--------------------------------------------------------------------------
+
+#pragma once
+
+#include <DD4hep/DetFactoryHelper.h>
+#include <DD4hep/Factories.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace epic::profiling {
+
+/// Resources used by a single factory call
+struct ConstructionRecord {
+  std::string name;           // detector (or field) name from the compact file
+  std::string type;           // factory type, e.g. epic_DRICH
+  double wall_ms         = 0; // wall clock time
+  double cpu_ms          = 0; // user + system CPU time
+  long peak_rss_delta_kb = 0; // growth of the process peak resident set size
+  long volumes           = 0; // TGeo volumes created
+  long nodes             = 0; // TGeo nodes placed in new volumes and in the world
+  long shapes            = 0; // TGeo shapes created
+};
+
+/// Process-wide collection of construction records
+class ConstructionProfiler {
+public:
+  static ConstructionProfiler& instance();
+
+  void add(ConstructionRecord record) { m_records.push_back(std::move(record)); }
+  const std::vector<ConstructionRecord>& records() const { return m_records; }
+
+  /// Write the report, format chosen by extension (.csv, otherwise json)
+  bool write(const std::string& path) const;
+
+  /// Writes the report to $EPIC_CONSTRUCTION_PROFILE, if set
+  ~ConstructionProfiler();
+
+private:
+  ConstructionProfiler() = default;
+  std::vector<ConstructionRecord> m_records;
+};
+
+/// RAII scope that measures one factory call
+class ConstructionScope {
+public:
+  ConstructionScope(dd4hep::Detector& desc, const char* type, const dd4hep::xml::Handle_t& e);
+  ~ConstructionScope();
+
+  ConstructionScope(const ConstructionScope&)            = delete;
+  ConstructionScope& operator=(const ConstructionScope&) = delete;
+
+private:
+  dd4hep::Detector& m_desc;
+  ConstructionRecord m_record;
+  std::chrono::steady_clock::time_point m_wall_start;
+  double m_cpu_start_ms;
+  long m_peak_rss_start_kb;
+  long m_volumes_start;
+  long m_shapes_start;
+  long m_world_nodes_start;
+};
+
+} // namespace epic::profiling
+
+// Profiled drop-in replacement for DECLARE_DETELEMENT
+#define DECLARE_PROFILED_DETELEMENT(name, func)                                                    \
+  static dd4hep::Ref_t name##_profiled(dd4hep::Detector& description, xml_h e,                     \
+                                       dd4hep::Ref_t sens) {                                       \
+    epic::profiling::ConstructionScope scope(description, #name, e);                               \
+    return func(description, e, sens);                                                             \
+  }                                                                                                \
+  DECLARE_DETELEMENT(name, name##_profiled)
+
+// Profiled drop-in replacement for DECLARE_XMLELEMENT
+#define DECLARE_PROFILED_XMLELEMENT(name, func)                                                    \
+  static dd4hep::Ref_t name##_profiled(dd4hep::Detector& description, xml_h e) {                   \
+    epic::profiling::ConstructionScope scope(description, #name, e);                               \
+    return func(description, e);                                                                   \
+  }                                                                                                \
+  DECLARE_XMLELEMENT(name, name##_profiled)
@@ -8,6 +8,7 @@
 #include "DDRec/Surface.h"
 #include "TMath.h"
 #include "XML/Layering.h"
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -59,4 +60,4 @@ static Ref_t build_magnet(Detector& dtor, xml_h e, SensitiveDetector /* sens */)
   return sdet;
 }
 
-DECLARE_DETELEMENT(ip6_CylindricalDipoleMagnet, build_magnet)
+DECLARE_PROFILED_DETELEMENT(ip6_CylindricalDipoleMagnet, build_magnet)
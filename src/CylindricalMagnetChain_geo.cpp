@@ -14,6 +14,7 @@
 #include "DDRec/Surface.h"
 #include "TMath.h"
 #include "XML/Layering.h"
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -61,4 +62,4 @@ static Ref_t create_magnet(Detector& description, xml_h e, SensitiveDetector /*
   return sdet;
 }
 
-DECLARE_DETELEMENT(CylindricalMagnetChain, create_magnet)
+DECLARE_PROFILED_DETELEMENT(CylindricalMagnetChain, create_magnet)
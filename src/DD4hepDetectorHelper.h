@@ -4,10 +4,16 @@
 #pragma once
 
 #include <DD4hep/DetElement.h>
+#include <DD4hep/ExtensionEntry.h>
+#include <DD4hep/Primitives.h>
 #include <DDRec/DetectorData.h>
+#include <DDRec/Surface.h>
 #include <boost/foreach.hpp>
 #include <boost/tokenizer.hpp>
 
+#include <memory>
+#include <string>
+
 #include "DD4hep/DetFactoryHelper.h"
 
 namespace DD4hepDetectorHelper {
@@ -21,6 +27,46 @@ template <typename T> T& ensureExtension(dd4hep::DetElement& elt) {
   return *ext;
 }
 
+// Extension entry for an object shared by many DetElements. Every DetElement holds a reference,
+// and the object is deleted with the last of them; clones of a DetElement share it as well.
+template <typename T> class SharedExtension : public dd4hep::ExtensionEntry {
+  std::shared_ptr<T> m_ptr;
+
+public:
+  explicit SharedExtension(std::shared_ptr<T> ptr) : m_ptr(std::move(ptr)) {}
+  void* object() const override { return m_ptr.get(); }
+  void* copy(void*) const override {
+    invalidCall("copy");
+    return nullptr;
+  }
+  void destruct() const override {}
+  dd4hep::ExtensionEntry* clone(void*) const override { return new SharedExtension<T>(m_ptr); }
+  unsigned long long int hash64() const override { return dd4hep::detail::typeHash64<T>(); }
+};
+
+template <typename T> void addSharedExtension(dd4hep::DetElement& elt, std::shared_ptr<T> ext) {
+  elt.addExtension(new SharedExtension<T>(std::move(ext)));
+}
+
+// Parameters and measurement surface shared by all sensors of one module type
+struct SensorDescriptor {
+  std::shared_ptr<dd4hep::rec::VariantParameters> params;
+  std::shared_ptr<dd4hep::rec::VolSurfaceList> surfaces;
+
+  SensorDescriptor(const std::string& axis_definitions, const dd4hep::rec::VolSurface& surface)
+      : params(std::make_shared<dd4hep::rec::VariantParameters>())
+      , surfaces(std::make_shared<dd4hep::rec::VolSurfaceList>()) {
+    params->set<std::string>("axis_definitions", axis_definitions);
+    surfaces->push_back(surface);
+  }
+
+  // attach to a sensor DetElement, in place of its own parameters and surface list
+  void attach(dd4hep::DetElement& elt) const {
+    addSharedExtension(elt, params);
+    addSharedExtension(elt, surfaces);
+  }
+};
+
 inline void xmlToProtoSurfaceMaterial(const xml_comp_t& x_material,
                                       dd4hep::rec::VariantParameters& params,
                                       const std::string& baseTag) {
@@ -32,6 +32,7 @@
 #include "TGeoManager.h"
 #include "TInterpreter.h"
 #include "TUri.h"
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -110,6 +111,6 @@ static Ref_t create_detector(Detector& description, xml_h e, Ref_t /* sens_det *
 }
 
 // first argument is the type from the xml file
-DECLARE_DETELEMENT(DD4hep_GdmlDetector, create_detector)
+DECLARE_PROFILED_DETELEMENT(DD4hep_GdmlDetector, create_detector)
 
 #endif
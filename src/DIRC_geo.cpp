@@ -7,6 +7,7 @@
 #include "DDRec/DetectorData.h"
 #include "DDRec/Surface.h"
 #include <XML/Helper.h>
+#include "ConstructionProfiler.h"
 
 //////////////////////////////////
 // Central Barrel DIRC
@@ -303,4 +304,4 @@ static dd4hep::Trap MakeTrap(const std::string& pName, double pZ, double pY, dou
               fTalpha2);
 }
 
-DECLARE_DETELEMENT(epic_DIRC, createDetector)
+DECLARE_PROFILED_DETELEMENT(epic_DIRC, createDetector)
@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 ePIC Collaboration
+
+//==========================================================================
+//  dRICH sensor table export
+//
+//  Writes the flat sensor table attached to the dRICH DetElement to a
+//  binary file, which can be read back with `SensorTable::read`.
+//--------------------------------------------------------------------------
+
+#include <DD4hep/DetFactoryHelper.h>
+#include <DD4hep/Factories.h>
+#include <DD4hep/Printout.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "DRICHSensorTable.h"
+
+using namespace dd4hep;
+
+static void usage_drich_sensor_table(int argc, char** argv) {
+  std::cerr
+      << "Usage: -plugin <name> -arg [-arg]                                                  \n"
+         "     output:<string>          binary sensor table file                             \n"
+         "     detector:<string>        dRICH detector name (default DRICH)                  \n"
+         "\tArguments given: "
+      << arguments(argc, argv) << std::endl;
+  std::exit(EINVAL);
+}
+
+// Plugin to write the dRICH sensor table to a binary file
+static long drich_sensor_table(Detector& desc, int argc, char** argv) {
+  std::string output, detector = "DRICH";
+  for (int i = 0; i < argc && argv[i]; ++i) {
+    if (0 == std::strncmp("output:", argv[i], 7))
+      output = (argv[i] + 7);
+    else if (0 == std::strncmp("detector:", argv[i], 9))
+      detector = (argv[i] + 9);
+    else {
+      std::cerr << "Unexpected argument \"" << argv[i] << "\"" << std::endl;
+      usage_drich_sensor_table(argc, argv);
+    }
+  }
+  if (output.empty()) {
+    usage_drich_sensor_table(argc, argv);
+  }
+
+  DetElement det = desc.detector(detector);
+  auto* table    = det.extension<epic::drich::SensorTable>(false);
+  if (table == nullptr) {
+    printout(ERROR, "DRICHSensorTable", "no sensor table on detector " + detector);
+    return 0;
+  }
+  if (!table->write(output)) {
+    printout(ERROR, "DRICHSensorTable", "unable to write " + output);
+    return 0;
+  }
+  printout(INFO, "DRICHSensorTable", "wrote %zu sensors to %s", table->sensors.size(),
+           output.c_str());
+  return 1;
+}
+
+DECLARE_APPLY(epic_DRICHSensorTable, drich_sensor_table)
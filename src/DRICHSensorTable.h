@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 ePIC Collaboration
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Flat table of dRICH sensor optics parameters
+//
+// The dRICH builder attaches one `SensorTable` extension to the dRICH DetElement, instead
+// of a `VariantParameters` map on each sensor DetElement. Entries are sorted by sensor ID,
+// so that a hit's sensor is found by a binary search on `cellID & cellMask`:
+//
+//   auto* table = det.extension<epic::drich::SensorTable>();
+//   if (const auto* sensor = table->find(hit.cellID)) { ... sensor->pos ... }
+//
+// The table can also be written to (and read from) a small binary file, see
+// the `epic_DRICHSensorTable` plugin.
+namespace epic::drich {
+
+struct Sensor {
+  std::uint64_t id;             // sensor ID, i.e. `cellID & cellMask`
+  std::array<double, 3> pos;    // centroid of the active surface (global coordinates)
+  std::array<double, 3> normX;  // sensor surface basis vector x
+  std::array<double, 3> normY;  // sensor surface basis vector y
+  double halfSide;              // half side length of the active surface
+};
+
+class SensorTable {
+public:
+  static constexpr std::uint32_t kMagic   = 0x54535244; // "DRST"
+  static constexpr std::uint32_t kVersion = 1;
+
+  std::uint64_t cellMask = 0;
+  std::vector<Sensor> sensors; // sorted by `id`
+
+  void add(const Sensor& sensor) { sensors.push_back(sensor); }
+
+  void sort() {
+    std::sort(sensors.begin(), sensors.end(),
+              [](const Sensor& a, const Sensor& b) { return a.id < b.id; });
+  }
+
+  // sensor containing this cellID, or nullptr
+  const Sensor* find(std::uint64_t cellID) const {
+    const std::uint64_t id = cellID & cellMask;
+
+    auto it = std::lower_bound(sensors.begin(), sensors.end(), id,
+                               [](const Sensor& s, std::uint64_t v) { return s.id < v; });
+    return (it != sensors.end() && it->id == id) ? &*it : nullptr;
+  }
+
+  bool write(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    const std::uint64_t count = sensors.size();
+    out.write(reinterpret_cast<const char*>(&kMagic), sizeof(kMagic));
+    out.write(reinterpret_cast<const char*>(&kVersion), sizeof(kVersion));
+    out.write(reinterpret_cast<const char*>(&cellMask), sizeof(cellMask));
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    out.write(reinterpret_cast<const char*>(sensors.data()), count * sizeof(Sensor));
+    return out.good();
+  }
+
+  bool read(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::uint32_t magic = 0, version = 0;
+    std::uint64_t count = 0;
+    in.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    if (!in || magic != kMagic || version != kVersion) {
+      return false;
+    }
+    in.read(reinterpret_cast<char*>(&cellMask), sizeof(cellMask));
+    in.read(reinterpret_cast<char*>(&count), sizeof(count));
+    sensors.resize(count);
+    in.read(reinterpret_cast<char*>(sensors.data()), count * sizeof(Sensor));
+    return in.good();
+  }
+};
+
+} // namespace epic::drich
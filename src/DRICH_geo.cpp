@@ -19,10 +19,151 @@
 #include "DDRec/Surface.h"
 
 #include <XML/Helper.h>
+#include "ConstructionProfiler.h"
+#include "DRICHSensorTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
 
 using namespace dd4hep;
 using namespace dd4hep::rec;
 
+namespace {
+
+// piecewise linear radii rmin(z), rmax(z) of a solid of revolution, from its z-planes
+struct RadialProfile {
+  std::vector<double> z, rmin, rmax;
+
+  void append(const TGeoPcon* pcon, double zpos) {
+    for (int i = 0; i < pcon->GetNz(); i++)
+      add(pcon->GetZ(i) + zpos, pcon->GetRmin(i), pcon->GetRmax(i));
+  }
+  void append(const TGeoCone* cone, double zpos) {
+    add(zpos - cone->GetDz(), cone->GetRmin1(), cone->GetRmax1());
+    add(zpos + cone->GetDz(), cone->GetRmin2(), cone->GetRmax2());
+  }
+  void add(double zi, double rmini, double rmaxi) {
+    if (!z.empty() && std::abs(z.back() - zi) < 1e-9 && rmin.back() == rmini &&
+        rmax.back() == rmaxi)
+      return;
+    z.push_back(zi);
+    rmin.push_back(rmini);
+    rmax.push_back(rmaxi);
+  }
+
+  static double at(const std::vector<double>& zs, const std::vector<double>& rs, double zi) {
+    if (zi <= zs.front())
+      return rs.front();
+    for (std::size_t i = 1; i < zs.size(); i++)
+      if (zi <= zs[i])
+        return std::lerp(rs[i - 1], rs[i], (zi - zs[i - 1]) / (zs[i] - zs[i - 1]));
+    return rs.back();
+  }
+
+  // full-azimuth polycone of the profile, with the outer radius capped at `rcap` for z in
+  // [zlo, zhi]
+  Polycone capped(double zlo, double zhi, double rcap) const {
+    std::vector<double> zs, rmins, rmaxs;
+    auto plane = [&](double zi, double rmini, double rmaxi) {
+      if (!zs.empty() && zs.back() == zi && rmins.back() == rmini && rmaxs.back() == rmaxi)
+        return;
+      zs.push_back(zi);
+      rmins.push_back(rmini);
+      rmaxs.push_back(rmaxi);
+    };
+    auto point = [&](double zi, double rmini, double rmaxi) {
+      bool atLow = std::abs(zi - zlo) < 1e-9, atHigh = std::abs(zi - zhi) < 1e-9;
+      if (atLow)
+        plane(zi, rmini, rmaxi);
+      plane(zi, rmini, (zi > zlo && zi < zhi) || atLow || atHigh ? std::min(rmaxi, rcap) : rmaxi);
+      if (atHigh)
+        plane(zi, rmini, rmaxi);
+    };
+    for (std::size_t i = 0; i < z.size(); i++) {
+      if (i > 0) {
+        // box edges and crossings of r(z) with `rcap` between the profile planes
+        std::vector<double> zc;
+        for (double ze : {zlo, zhi})
+          if (ze > z[i - 1] + 1e-9 && ze < z[i] - 1e-9)
+            zc.push_back(ze);
+        if ((rmax[i - 1] - rcap) * (rmax[i] - rcap) < 0) {
+          double zx = std::lerp(z[i - 1], z[i], (rcap - rmax[i - 1]) / (rmax[i] - rmax[i - 1]));
+          if (zx > zlo && zx < zhi)
+            zc.push_back(zx);
+        }
+        std::sort(zc.begin(), zc.end());
+        for (double zi : zc)
+          point(zi, at(z, rmin, zi), at(z, rmax, zi));
+      }
+      point(z[i], rmin[i], rmax[i]);
+    }
+    return Polycone(0, 2 * M_PI, rmins, rmaxs, zs);
+  }
+
+  // azimuthal segment between `rfloor` and r(z), for z in [zlo, zhi]; the segment starts
+  // where r(z) reaches `rfloor` (r(z) must be non-decreasing in [zlo, zhi])
+  std::optional<Polycone> inner(double zlo, double zhi, double rfloor, double startPhi,
+                                double deltaPhi) const {
+    std::vector<double> zs = {zlo, zhi};
+    for (std::size_t i = 0; i < z.size(); i++) {
+      if (z[i] > zlo && z[i] < zhi)
+        zs.push_back(z[i]);
+      if (i > 0 && (rmax[i - 1] - rfloor) * (rmax[i] - rfloor) < 0) {
+        double zc = std::lerp(z[i - 1], z[i], (rfloor - rmax[i - 1]) / (rmax[i] - rmax[i - 1]));
+        if (zc > zlo && zc < zhi)
+          zs.push_back(zc);
+      }
+    }
+    std::sort(zs.begin(), zs.end());
+    std::vector<double> zf, rminf, rmaxf;
+    for (double zi : zs) {
+      double rhigh = at(z, rmax, zi);
+      if (rhigh < rfloor - 1e-9)
+        continue;
+      zf.push_back(zi);
+      rminf.push_back(rfloor);
+      rmaxf.push_back(std::max(rhigh, rfloor));
+    }
+    if (zf.size() < 2)
+      return std::nullopt;
+    return Polycone(startPhi, deltaPhi, rminf, rmaxf, zf);
+  }
+
+  // azimuthal segment between max(r(z), `rfloor`) and `rceil`, for z in [zlo, zhi];
+  // the segment ends where r(z) reaches `rceil` (r(z) must be non-decreasing in [zlo, zhi])
+  std::optional<Polycone> filler(double zlo, double zhi, double rfloor, double rceil,
+                                 double startPhi, double deltaPhi) const {
+    std::vector<double> zs = {zlo, zhi};
+    for (std::size_t i = 0; i < z.size(); i++) {
+      if (z[i] > zlo && z[i] < zhi)
+        zs.push_back(z[i]);
+      // crossings of r(z) with `rfloor` and `rceil`
+      for (double rc : {rfloor, rceil})
+        if (i > 0 && (rmax[i - 1] - rc) * (rmax[i] - rc) < 0) {
+          double zc = std::lerp(z[i - 1], z[i], (rc - rmax[i - 1]) / (rmax[i] - rmax[i - 1]));
+          if (zc > zlo && zc < zhi)
+            zs.push_back(zc);
+        }
+    }
+    std::sort(zs.begin(), zs.end());
+    std::vector<double> zf, rminf, rmaxf;
+    for (double zi : zs) {
+      double rlow = std::max(rfloor, at(z, rmax, zi));
+      if (rlow > rceil)
+        break;
+      zf.push_back(zi);
+      rminf.push_back(rlow);
+      rmaxf.push_back(rceil);
+    }
+    if (zf.size() < 2)
+      return std::nullopt;
+    return Polycone(startPhi, deltaPhi, rminf, rmaxf, zf);
+  }
+};
+
+} // namespace
+
 // create the detector
 static Ref_t createDetector(Detector& desc, xml::Handle_t handle, SensitiveDetector sens) {
 
@@ -121,10 +262,12 @@ static Ref_t createDetector(Detector& desc, xml::Handle_t handle, SensitiveDetec
   // - sensor readout
   auto readoutName = detElem.attr<std::string>(_Unicode(readout));
   // - settings and switches
-  auto debugOpticsMode = desc.constant<int>("DRICH_debug_optics");
-  bool debugSector     = desc.constant<int>("DRICH_debug_sector") == 1;
-  bool debugMirror     = desc.constant<int>("DRICH_debug_mirror") == 1;
-  bool debugSensors    = desc.constant<int>("DRICH_debug_sensors") == 1;
+  auto debugOpticsMode        = desc.constant<int>("DRICH_debug_optics");
+  bool debugSector            = desc.constant<int>("DRICH_debug_sector") == 1;
+  bool debugMirror            = desc.constant<int>("DRICH_debug_mirror") == 1;
+  bool debugSensors           = desc.constant<int>("DRICH_debug_sensors") == 1;
+  bool legacySensorParameters = desc.constant<int>("DRICH_legacy_sensor_parameters") == 1;
+  auto vesselMode             = desc.constant<int>("DRICH_vessel_mode");
 
   // if debugging optics, override some settings
   bool debugOptics = debugOpticsMode > 0;
@@ -171,6 +314,10 @@ static Ref_t createDetector(Detector& desc, xml::Handle_t handle, SensitiveDetec
     return enc;
   };
 
+  // sensor optics parameters, filled in the sensor loop below
+  auto sensorTable      = new epic::drich::SensorTable();
+  sensorTable->cellMask = cellMask;
+
   // BUILD VESSEL ====================================================================
   /* - `vessel`: aluminum enclosure, the mother volume of the dRICH
    * - `gasvol`: gas volume, which fills `vessel`; all other volumes defined below
@@ -242,7 +389,8 @@ static Ref_t createDetector(Detector& desc, xml::Handle_t handle, SensitiveDetec
     RotationZ sectorRotation((isec + 0.5) * 2 * M_PI / nSectors);
     vesselUnion = UnionSolid(
         vesselUnion, vesselSensorboxTube,
-        Transform3D(sectorRotation, Position(0., 0., -(snoutLength + sensorboxLength - 0.6) / 2.)));
+        Transform3D(sectorRotation,
+                    Position(0., 0., -(snoutLength + sensorboxLength) / 2. + windowThickness)));
     gasvolUnion = UnionSolid(
         gasvolUnion, gasvolSensorboxTube,
         Transform3D(sectorRotation,
@@ -271,12 +419,116 @@ static Ref_t createDetector(Detector& desc, xml::Handle_t handle, SensitiveDetec
     break;
   }
 
+  // boolean-free vessel and gasvol solids (`vesselMode == 1`, not with `debugOptics`)
+  /* - `vessel` and `gasvol` are full-azimuth polycones which follow the snout and tank
+   *   profiles, with the outer radius capped at the sensor box inner radius along the
+   *   sensor box length
+   * - above that radius, along the sensor box length, each sector has a sensor box volume
+   *   (the union sensor box tube, holding the PDUs) and a gap volume between the sensor
+   *   boxes (the tank up to its profile), each with its gas daughters
+   * - all of these volumes stay within the union of snout, tank and sensor boxes, and are
+   *   placed in an assembly which takes the place of the vessel in the mother volume
+   * - optical photons in the gas then only navigate plain polycones and tube segments,
+   *   instead of the chain of boolean unions
+   */
+  bool vesselPolycone = vesselMode == 1 && !debugOptics;
+  RadialProfile vesselProfile, gasvolProfile;
+  double sensorboxZmin = -(snoutLength + sensorboxLength) / 2. + windowThickness -
+                         sensorboxLength / 2.;
+  double sensorboxZmax = sensorboxZmin + sensorboxLength;
+  if (vesselPolycone) {
+    vesselProfile.append(vesselSnout.ptr(), -vesselLength / 2.);
+    vesselProfile.append(vesselTank.ptr(), 0.);
+    gasvolProfile.append(gasvolSnout.ptr(), -vesselLength / 2. + windowThickness);
+    gasvolProfile.append(gasvolTank.ptr(), 0.);
+    vesselSolid = vesselProfile.capped(sensorboxZmin, sensorboxZmax, sensorboxRmin);
+    gasvolSolid = gasvolProfile.capped(sensorboxZmin, sensorboxZmax, sensorboxRmin);
+  }
+
   // volumes
   Volume vesselVol(detName, vesselSolid, vesselMat);
   Volume gasvolVol(detName + "_gas", gasvolSolid, gasvolMat);
   vesselVol.setVisAttributes(vesselVis);
   gasvolVol.setVisAttributes(gasvolVis);
 
+  // sensor box and gap volumes above the capped polycones, per sector
+  Volume topVol = vesselVol;
+  std::vector<Volume> sensorboxGasVols;
+  std::vector<Transform3D> sensorboxTransforms;
+  if (vesselPolycone) {
+    Assembly vesselAssembly(detName + "_assembly");
+    vesselAssembly.placeVolume(vesselVol);
+    topVol = vesselAssembly;
+
+    double sectorDphi    = 2 * M_PI / nSectors;
+    double sensorboxZ    = (sensorboxZmin + sensorboxZmax) / 2.;
+    double gasvolBoxDphi = sensorboxDphi - 2 * dphi;
+    double gasvolBoxRmin = sensorboxRmin + wallThickness;
+    double gasvolBoxRmax = sensorboxRmax - wallThickness;
+    double gapStartPhi   = sensorboxDphi / 2.;
+    double gapDphi       = sectorDphi - sensorboxDphi;
+    // volume of an optional solid (the profile may not reach above the cap), placed once
+    auto profileVol = [&](Volume fillerMotherVol, std::optional<Polycone> fillerSolid,
+                          std::string fillerName, Material fillerMat, VisAttr fillerVis,
+                          const Transform3D& fillerPlacement) {
+      Volume fillerVol;
+      if (!fillerSolid)
+        return fillerVol;
+      fillerVol = Volume(detName + "_" + fillerName, *fillerSolid, fillerMat);
+      fillerVol.setVisAttributes(fillerVis);
+      fillerMotherVol.placeVolume(fillerVol, fillerPlacement);
+      return fillerVol;
+    };
+
+    // - sensor box: the union sensor box tube, with gas in the gas sensor box tube and below
+    //   the gas profile; the sensor box wall is kept where the gas profile does not reach
+    Transform3D profileToBox(Translation3D(0., 0., -sensorboxZ));
+    Tube sensorboxSolid(sensorboxRmin, sensorboxRmax, sensorboxLength / 2., -sensorboxDphi / 2.,
+                        sensorboxDphi / 2.);
+    Tube sensorboxGasSolid(sensorboxRmin, gasvolBoxRmax, sensorboxLength / 2.,
+                           -gasvolBoxDphi / 2., gasvolBoxDphi / 2.);
+    auto sensorboxWallSolid = gasvolProfile.filler(sensorboxZmin, sensorboxZmax, sensorboxRmin,
+                                                   gasvolBoxRmin, -gasvolBoxDphi / 2.,
+                                                   gasvolBoxDphi);
+    auto sensorboxEdgeSolid = [&](double startPhi) {
+      return gasvolProfile.inner(sensorboxZmin, sensorboxZmax, sensorboxRmin, startPhi, dphi);
+    };
+    // - gap: the tank between the sensor boxes, above the cap
+    auto gapVol = profileVol(vesselAssembly,
+                             vesselProfile.inner(sensorboxZmin, sensorboxZmax, sensorboxRmin,
+                                                 gapStartPhi, gapDphi),
+                             "gap", vesselMat, vesselVis, Transform3D());
+    if (gapVol.isValid())
+      profileVol(gapVol,
+                 gasvolProfile.inner(sensorboxZmin, sensorboxZmax, sensorboxRmin, gapStartPhi,
+                                     gapDphi),
+                 "gap_gas", gasvolMat, gasvolVis, Transform3D());
+
+    // one sensor box per sector, since each holds its own PDUs
+    for (int isec = 0; isec < nSectors; isec++) {
+      RotationZ sectorRotation((isec + 0.5) * sectorDphi);
+      std::string secName = "sec" + std::to_string(isec);
+      Volume sensorboxVol(detName + "_sensorbox_" + secName, sensorboxSolid, vesselMat);
+      Volume sensorboxGasVol(detName + "_sensorbox_gas_" + secName, sensorboxGasSolid,
+                             gasvolMat);
+      sensorboxVol.setVisAttributes(vesselVis);
+      sensorboxGasVol.setVisAttributes(gasvolVis);
+      sensorboxVol.placeVolume(sensorboxGasVol);
+      profileVol(sensorboxGasVol, sensorboxWallSolid, "sensorbox_wall_" + secName, vesselMat,
+                 vesselVis, profileToBox);
+      // gas at the low- and high-phi edges of the sensor box, outside the gas sensor box
+      profileVol(sensorboxVol, sensorboxEdgeSolid(-sensorboxDphi / 2.),
+                 "sensorbox_edge_gas_lo_" + secName, gasvolMat, gasvolVis, profileToBox);
+      profileVol(sensorboxVol, sensorboxEdgeSolid(gasvolBoxDphi / 2.),
+                 "sensorbox_edge_gas_hi_" + secName, gasvolMat, gasvolVis, profileToBox);
+      sensorboxGasVols.push_back(sensorboxGasVol);
+      sensorboxTransforms.emplace_back(sectorRotation, Position(0., 0., sensorboxZ));
+      vesselAssembly.placeVolume(sensorboxVol, sensorboxTransforms.back());
+      if (gapVol.isValid())
+        vesselAssembly.placeVolume(gapVol, Transform3D(sectorRotation));
+    }
+  }
+
   // reference positions
   // - the vessel is created such that the center of the cylindrical tank volume
   //   coincides with the origin; this is called the "origin position" of the vessel
@@ -295,7 +547,7 @@ static Ref_t createDetector(Detector& desc, xml::Handle_t handle, SensitiveDetec
 
   // place mother volume (vessel)
   Volume motherVol      = desc.pickMotherVolume(det);
-  PlacedVolume vesselPV = motherVol.placeVolume(vesselVol, vesselPos);
+  PlacedVolume vesselPV = motherVol.placeVolume(topVol, vesselPos);
   vesselPV.addPhysVolID("system", detID);
   det.setPlacement(vesselPV);
 
@@ -483,6 +735,109 @@ static Ref_t createDetector(Detector& desc, xml::Handle_t handle, SensitiveDetec
     if (isec == 0)
       desc.add(Constant("DRICH_sensor_sph_radius", std::to_string(sensorSphRadius)));
 
+    // SENSOR AND PDU SERVICE VOLUMES ------------------------
+    /* - all PDUs of a sector are identical, so the sensor, resin, service and board
+     *   volumes are built once per sector and placed in every PDU
+     */
+
+    // photosensitive surface (pss) and resin solids
+    Box pssSolid(pssSide / 2., pssSide / 2., pssThickness / 2.);
+    Box resinSolid(resinSide / 2., resinSide / 2., resinThickness / 2.);
+
+    // embed pss solid in resin solid, by subtracting `pssSolid` from `resinSolid`
+    SubtractionSolid resinSolidEmbedded(
+        resinSolid, pssSolid,
+        Transform3D(Translation3D(0., 0., (resinThickness - pssThickness) / 2.)));
+
+    /* NOTE:
+     * Here we could add gaps (size=`DRICH_pixel_gap`) between the pixels
+     * as additional resin volumes, but this would require several more
+     * iterative boolean operations, which may cause significant
+     * performance slow downs in the simulation. Alternatively, one can
+     * create a pixel gap mask with several disjoint, thin `Box` volumes
+     * just outside the pss surface (no booleans required), but this
+     * would amount to a very large number of additional volumes. Instead,
+     * we have decided to apply pixel gap masking to the digitization
+     * algorithm, downstream in reconstruction.
+     */
+
+    // pss and resin volumes
+    Volume pssVol(detName + "_pss_" + secName, pssSolid, pssMat);
+    Volume resinVol(detName + "_resin_" + secName, resinSolidEmbedded, resinMat);
+    pssVol.setVisAttributes(pssVis);
+    resinVol.setVisAttributes(resinVis);
+
+    // sensitivity and surface properties; a single skin surface covers every
+    // placement of the shared `pssVol`
+    if (!debugOptics || debugOpticsMode == 3) {
+      pssVol.setSensitiveDetector(sens);
+      SkinSurface pssSkin(desc, det, "sensor_optical_surface_" + secName, pssSurf, pssVol);
+      pssSkin.isValid();
+    }
+
+    // PDU front service, circuit board and back service volumes, with their placements in
+    // the PDU assembly
+    std::vector<std::pair<Volume, Transform3D>> pduServicePlacements;
+
+    // front service volumes
+    Transform3D frontServiceTransformation = Transform3D(Translation3D(0., 0., -resinThickness));
+    for (xml::Collection_t serviceElem(pduElem.child(_Unicode(frontservices)), _Unicode(service));
+         serviceElem; ++serviceElem) {
+      auto serviceName      = serviceElem.attr<std::string>(_Unicode(name));
+      auto serviceSide      = serviceElem.attr<double>(_Unicode(side));
+      auto serviceThickness = serviceElem.attr<double>(_Unicode(thickness));
+      auto serviceMat       = desc.material(serviceElem.attr<std::string>(_Unicode(material)));
+      auto serviceVis       = desc.visAttributes(serviceElem.attr<std::string>(_Unicode(vis)));
+      Box serviceSolid(serviceSide / 2.0, serviceSide / 2.0, serviceThickness / 2.0);
+      Volume serviceVol(detName + "_" + serviceName + "_" + secName, serviceSolid, serviceMat);
+      serviceVol.setVisAttributes(serviceVis);
+      frontServiceTransformation =
+          Transform3D(Translation3D(0., 0., -serviceThickness / 2.0)) * frontServiceTransformation;
+      pduServicePlacements.emplace_back(serviceVol, frontServiceTransformation);
+      frontServiceTransformation =
+          Transform3D(Translation3D(0., 0., -serviceThickness / 2.0)) * frontServiceTransformation;
+    }
+
+    // circuit board volumes
+    auto boardsElem = pduElem.child(_Unicode(boards));
+    auto boardsMat  = desc.material(boardsElem.attr<std::string>(_Unicode(material)));
+    auto boardsVis  = desc.visAttributes(boardsElem.attr<std::string>(_Unicode(vis)));
+    Transform3D backServiceTransformation;
+    for (xml::Collection_t boardElem(boardsElem, _Unicode(board)); boardElem; ++boardElem) {
+      auto boardName      = boardElem.attr<std::string>(_Unicode(name));
+      auto boardWidth     = boardElem.attr<double>(_Unicode(width));
+      auto boardLength    = boardElem.attr<double>(_Unicode(length));
+      auto boardThickness = boardElem.attr<double>(_Unicode(thickness));
+      auto boardOffset    = boardElem.attr<double>(_Unicode(offset));
+      Box boardSolid(boardWidth / 2.0, boardThickness / 2.0, boardLength / 2.0);
+      Volume boardVol(detName + "_" + boardName + "+" + secName, boardSolid, boardsMat);
+      boardVol.setVisAttributes(boardsVis);
+      auto boardTransformation =
+          Translation3D(0., boardOffset, -boardLength / 2.0) * frontServiceTransformation;
+      pduServicePlacements.emplace_back(boardVol, boardTransformation);
+      if (boardName == "RDO")
+        backServiceTransformation =
+            Translation3D(0., 0., -boardLength) * frontServiceTransformation;
+    }
+
+    // back service volumes
+    for (xml::Collection_t serviceElem(pduElem.child(_Unicode(backservices)), _Unicode(service));
+         serviceElem; ++serviceElem) {
+      auto serviceName      = serviceElem.attr<std::string>(_Unicode(name));
+      auto serviceSide      = serviceElem.attr<double>(_Unicode(side));
+      auto serviceThickness = serviceElem.attr<double>(_Unicode(thickness));
+      auto serviceMat       = desc.material(serviceElem.attr<std::string>(_Unicode(material)));
+      auto serviceVis       = desc.visAttributes(serviceElem.attr<std::string>(_Unicode(vis)));
+      Box serviceSolid(serviceSide / 2.0, serviceSide / 2.0, serviceThickness / 2.0);
+      Volume serviceVol(detName + "_" + serviceName + "_" + secName, serviceSolid, serviceMat);
+      serviceVol.setVisAttributes(serviceVis);
+      backServiceTransformation =
+          Transform3D(Translation3D(0., 0., -serviceThickness / 2.0)) * backServiceTransformation;
+      pduServicePlacements.emplace_back(serviceVol, backServiceTransformation);
+      backServiceTransformation =
+          Transform3D(Translation3D(0., 0., -serviceThickness / 2.0)) * backServiceTransformation;
+    }
+
     // SENSOR MODULE LOOP ------------------------
     /* ALGORITHM: generate sphere of positions
      * - NOTE: there are two coordinate systems here:
@@ -560,37 +915,6 @@ static Ref_t createDetector(Detector& desc, xml::Handle_t handle, SensitiveDetec
            *       so keep in mind the very small offset)
            */
 
-          // photosensitive surface (pss) and resin solids
-          Box pssSolid(pssSide / 2., pssSide / 2., pssThickness / 2.);
-          Box resinSolid(resinSide / 2., resinSide / 2., resinThickness / 2.);
-
-          // embed pss solid in resin solid, by subtracting `pssSolid` from `resinSolid`
-          SubtractionSolid resinSolidEmbedded(
-              resinSolid, pssSolid,
-              Transform3D(Translation3D(0., 0., (resinThickness - pssThickness) / 2.)));
-
-          /* NOTE:
-           * Here we could add gaps (size=`DRICH_pixel_gap`) between the pixels
-           * as additional resin volumes, but this would require several more
-           * iterative boolean operations, which may cause significant
-           * performance slow downs in the simulation. Alternatively, one can
-           * create a pixel gap mask with several disjoint, thin `Box` volumes
-           * just outside the pss surface (no booleans required), but this
-           * would amount to a very large number of additional volumes. Instead,
-           * we have decided to apply pixel gap masking to the digitization
-           * algorithm, downstream in reconstruction.
-           */
-
-          // pss and resin volumes
-          Volume pssVol(detName + "_pss_" + secName, pssSolid, pssMat);
-          Volume resinVol(detName + "_resin_" + secName, resinSolidEmbedded, resinMat);
-          pssVol.setVisAttributes(pssVis);
-          resinVol.setVisAttributes(resinVis);
-
-          // sensitivity
-          if (!debugOptics || debugOpticsMode == 3)
-            pssVol.setSensitiveDetector(sens);
-
           // PDU placement definition: describe how to place a PDU on the sphere
           /* - transformations operate on global coordinates; the corresponding
            *   generator coordinates are provided in the comments
@@ -648,13 +972,6 @@ static Ref_t createDetector(Detector& desc, xml::Handle_t handle, SensitiveDetec
               DetElement pssDE(det, "sensor_de_" + sensorIDname, sensorID);
               pssDE.setPlacement(pssPV);
 
-              // sensor surface properties
-              if (!debugOptics || debugOpticsMode == 3) {
-                SkinSurface pssSkin(desc, pssDE, "sensor_optical_surface_" + sensorIDname, pssSurf,
-                                    pssVol);
-                pssSkin.isValid();
-              }
-
               // obtain some parameters useful for optics, so we don't have to figure them out downstream
               // - sensor position: the centroid of the active SURFACE of the `pss`
               auto pduOrigin = ROOT::Math::XYZPoint(0, 0, 0);
@@ -718,100 +1035,48 @@ static Ref_t createDetector(Detector& desc, xml::Handle_t handle, SensitiveDetec
                 throw std::runtime_error("dRICH sensor orientation test failed");
               }
 
-              // add these optics parameters to this sensor's parameter map
-              auto pssVarMap = pssDE.extension<VariantParameters>(false);
-              if (pssVarMap == nullptr) {
-                pssVarMap = new VariantParameters();
-                pssDE.addExtension<VariantParameters>(pssVarMap);
-              }
-              auto addVecToMap = [pssVarMap](std::string key, auto vec) {
-                pssVarMap->set<double>(key + "_x", vec.x());
-                pssVarMap->set<double>(key + "_y", vec.y());
-                pssVarMap->set<double>(key + "_z", vec.z());
+              // add these optics parameters to the sensor table
+              auto toArray = [](auto vec) {
+                return std::array<double, 3>{vec.x(), vec.y(), vec.z()};
               };
-              addVecToMap("pos", sensorPos);
-              addVecToMap("normX", sensorNormX);
-              addVecToMap("normY", sensorNormY);
-              printout(DEBUG, "DRICH_geo", "sensor %s:", sensorIDname.c_str());
-              for (auto kv : pssVarMap->variantParameters)
-                printout(DEBUG, "DRICH_geo", "    %s: %f", kv.first.c_str(),
-                         pssVarMap->get<double>(kv.first));
+              sensorTable->add({sensorID, toArray(sensorPos), toArray(sensorNormX),
+                                toArray(sensorNormY), pssSide / 2.});
+              printout(DEBUG, "DRICH_geo", "sensor %s: pos=(%f, %f, %f)", sensorIDname.c_str(),
+                       sensorPos.x(), sensorPos.y(), sensorPos.z());
+
+              // legacy per-sensor parameter map, for consumers that do not read the table yet
+              if (legacySensorParameters) {
+                auto pssVarMap = pssDE.extension<VariantParameters>(false);
+                if (pssVarMap == nullptr) {
+                  pssVarMap = new VariantParameters();
+                  pssDE.addExtension<VariantParameters>(pssVarMap);
+                }
+                auto addVecToMap = [pssVarMap](std::string key, auto vec) {
+                  pssVarMap->set<double>(key + "_x", vec.x());
+                  pssVarMap->set<double>(key + "_y", vec.y());
+                  pssVarMap->set<double>(key + "_z", vec.z());
+                };
+                addVecToMap("pos", sensorPos);
+                addVecToMap("normX", sensorNormX);
+                addVecToMap("normY", sensorNormY);
+              }
 
               // increment SIPM number
               isipm++;
             }
           } // end PDU SiPM matrix loop
 
-          // front service volumes
-          Transform3D frontServiceTransformation =
-              Transform3D(Translation3D(0., 0., -resinThickness));
-          for (xml::Collection_t serviceElem(pduElem.child(_Unicode(frontservices)),
-                                             _Unicode(service));
-               serviceElem; ++serviceElem) {
-            auto serviceName      = serviceElem.attr<std::string>(_Unicode(name));
-            auto serviceSide      = serviceElem.attr<double>(_Unicode(side));
-            auto serviceThickness = serviceElem.attr<double>(_Unicode(thickness));
-            auto serviceMat = desc.material(serviceElem.attr<std::string>(_Unicode(material)));
-            auto serviceVis = desc.visAttributes(serviceElem.attr<std::string>(_Unicode(vis)));
-            Box serviceSolid(serviceSide / 2.0, serviceSide / 2.0, serviceThickness / 2.0);
-            Volume serviceVol(detName + "_" + serviceName + "_" + secName, serviceSolid,
-                              serviceMat);
-            serviceVol.setVisAttributes(serviceVis);
-            frontServiceTransformation =
-                Transform3D(Translation3D(0., 0., -serviceThickness / 2.0)) *
-                frontServiceTransformation;
-            pduAssembly.placeVolume(serviceVol, frontServiceTransformation);
-            frontServiceTransformation =
-                Transform3D(Translation3D(0., 0., -serviceThickness / 2.0)) *
-                frontServiceTransformation;
-          }
-
-          // circuit board volumes
-          auto boardsElem = pduElem.child(_Unicode(boards));
-          auto boardsMat  = desc.material(boardsElem.attr<std::string>(_Unicode(material)));
-          auto boardsVis  = desc.visAttributes(boardsElem.attr<std::string>(_Unicode(vis)));
-          Transform3D backServiceTransformation;
-          for (xml::Collection_t boardElem(boardsElem, _Unicode(board)); boardElem; ++boardElem) {
-            auto boardName      = boardElem.attr<std::string>(_Unicode(name));
-            auto boardWidth     = boardElem.attr<double>(_Unicode(width));
-            auto boardLength    = boardElem.attr<double>(_Unicode(length));
-            auto boardThickness = boardElem.attr<double>(_Unicode(thickness));
-            auto boardOffset    = boardElem.attr<double>(_Unicode(offset));
-            Box boardSolid(boardWidth / 2.0, boardThickness / 2.0, boardLength / 2.0);
-            Volume boardVol(detName + "_" + boardName + "+" + secName, boardSolid, boardsMat);
-            boardVol.setVisAttributes(boardsVis);
-            auto boardTransformation =
-                Translation3D(0., boardOffset, -boardLength / 2.0) * frontServiceTransformation;
-            pduAssembly.placeVolume(boardVol, boardTransformation);
-            if (boardName == "RDO")
-              backServiceTransformation =
-                  Translation3D(0., 0., -boardLength) * frontServiceTransformation;
-          }
-
-          // back service volumes
-          for (xml::Collection_t serviceElem(pduElem.child(_Unicode(backservices)),
-                                             _Unicode(service));
-               serviceElem; ++serviceElem) {
-            auto serviceName      = serviceElem.attr<std::string>(_Unicode(name));
-            auto serviceSide      = serviceElem.attr<double>(_Unicode(side));
-            auto serviceThickness = serviceElem.attr<double>(_Unicode(thickness));
-            auto serviceMat = desc.material(serviceElem.attr<std::string>(_Unicode(material)));
-            auto serviceVis = desc.visAttributes(serviceElem.attr<std::string>(_Unicode(vis)));
-            Box serviceSolid(serviceSide / 2.0, serviceSide / 2.0, serviceThickness / 2.0);
-            Volume serviceVol(detName + "_" + serviceName + "_" + secName, serviceSolid,
-                              serviceMat);
-            serviceVol.setVisAttributes(serviceVis);
-            backServiceTransformation =
-                Transform3D(Translation3D(0., 0., -serviceThickness / 2.0)) *
-                backServiceTransformation;
-            pduAssembly.placeVolume(serviceVol, backServiceTransformation);
-            backServiceTransformation =
-                Transform3D(Translation3D(0., 0., -serviceThickness / 2.0)) *
-                backServiceTransformation;
-          }
+          // service and board volumes
+          for (const auto& [serviceVol, serviceTransformation] : pduServicePlacements)
+            pduAssembly.placeVolume(serviceVol, serviceTransformation);
 
           // place PDU assembly
-          gasvolVol.placeVolume(pduAssembly, pduAssemblyPlacement);
+          if (vesselPolycone)
+            sensorboxGasVols[isec].placeVolume(pduAssembly,
+                                               sensorboxTransforms[isec].Inverse() *
+                                                   pduAssemblyPlacement);
+          else
+            gasvolVol.placeVolume(pduAssembly, pduAssemblyPlacement);
 
           // increment PDU number
           ipdu++;
@@ -830,8 +1095,13 @@ static Ref_t createDetector(Detector& desc, xml::Handle_t handle, SensitiveDetec
 
   } // END SECTOR LOOP //////////////////////////
 
+  // attach the sensor table, sorted by sensor ID
+  sensorTable->sort();
+  det.addExtension<epic::drich::SensorTable>(sensorTable);
+  printout(INFO, "DRICH_geo", "sensor table with %zu sensors", sensorTable->sensors.size());
+
   return det;
 }
 
 // clang-format off
-DECLARE_DETELEMENT(epic_DRICH, createDetector)
+DECLARE_PROFILED_DETELEMENT(epic_DRICH, createDetector)
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 ePIC Collaboration
+
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// Runtime detector subset selection
+//
+// DD4hep skips <detector> elements based on the colon-separated lists in the
+// environment variables REQUIRED_DETECTORS, REQUIRED_DETECTOR_TYPES,
+// IGNORED_DETECTORS and IGNORED_DETECTOR_TYPES, e.g.
+//   REQUIRED_DETECTORS=":DRICH:" ddsim --compactFile epic_craterlake.xml ...
+// An entry matches where ":<name>:" occurs in the list, as DD4hep matches it
+// with strstr, so every name needs a colon on both sides (":DRICH:PFRICH:").
+// The helpers below apply the same lists to the file downloads that detectors
+// depend on, so that they are skipped as well. Fields do not follow the
+// detector selection: a field map is only replaced by a zero field when it is
+// listed explicitly in IGNORED_FIELDS, e.g.
+//   IGNORED_FIELDS=":GlobalSolenoid:" ddsim --compactFile epic_craterlake.xml ...
+namespace DetectorSelection {
+
+// true if ":value:" occurs in the list, the DD4hep match of the selection lists
+inline bool inList(const char* list, const std::string& value) {
+  if (list == nullptr || value.empty()) {
+    return false;
+  }
+  return std::strstr(list, (":" + value + ":").c_str()) != nullptr;
+}
+
+// true if the detector (or field) with this name and type would be built
+inline bool isSelected(const std::string& name, const std::string& type = "") {
+  const char* req_dets = std::getenv("REQUIRED_DETECTORS");
+  const char* req_typs = std::getenv("REQUIRED_DETECTOR_TYPES");
+  const char* ign_dets = std::getenv("IGNORED_DETECTORS");
+  const char* ign_typs = std::getenv("IGNORED_DETECTOR_TYPES");
+  if (req_dets != nullptr && !inList(req_dets, name)) {
+    return false;
+  }
+  if (req_typs != nullptr && !type.empty() && !inList(req_typs, type)) {
+    return false;
+  }
+  return !inList(ign_dets, name) && !inList(ign_typs, type);
+}
+
+// true if the field with this name is explicitly deselected
+inline bool isFieldIgnored(const std::string& name) {
+  return inList(std::getenv("IGNORED_FIELDS"), name);
+}
+
+} // namespace DetectorSelection
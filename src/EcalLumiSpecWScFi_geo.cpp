@@ -10,6 +10,7 @@ W Scifi (EM Calorimeter) Pair Spectrometer */
 #include <iostream>
 #include <tuple>
 #include <TVector3.h>
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -205,4 +206,4 @@ static tuple<Volume, Position> build_specScFiCAL_module(const Detector& descript
 
 } // build_specScifiCAL_module function close
 
-DECLARE_DETELEMENT(EcalLumiSpecWScFi, create_detector)
+DECLARE_PROFILED_DETELEMENT(EcalLumiSpecWScFi, create_detector)
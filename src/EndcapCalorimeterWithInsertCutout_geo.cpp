@@ -10,6 +10,8 @@
 #include "DD4hep/DetFactoryHelper.h"
 #include <XML/Helper.h>
 #include <XML/Layering.h>
+#include "ConstructionProfiler.h"
+#include "LayeredCalorimeterBuilder.h"
 
 using namespace dd4hep;
 
@@ -42,79 +44,51 @@ static Ref_t createDetector(Detector& desc, xml_h handle, SensitiveDetector sens
   Volume envelopeVol(detName, envelope_with_inserthole, air);
   // Setting envelope attributes
   envelopeVol.setAttributes(desc, detElem.regionStr(), detElem.limitsStr(), detElem.visStr());
-  PlacedVolume pv;
 
   int layer_num  = 1;
   double layer_z = -length / 2.; // Keeps track of layers' local z locations
+  epic::calorimeter::BudgetSummary budgets;
   // Looping through all the different layer sections
   for (xml_coll_t c(detElem, _U(layer)); c; ++c) {
     xml_comp_t x_layer     = c;
     int repeat             = x_layer.repeat();
     double layer_thickness = x_layer.thickness();
 
-    // Looping through the number of repeated layers in each section
-    for (int i = 0; i < repeat; i++) {
-      layer_z += layer_thickness / 2.; // Going to halfway point in layer
-
-      std::string layer_name = detName + _toString(layer_num, "_layer%d");
-      Tube layer(rmin, rmax, layer_thickness / 2.);
-
-      // Removing insert shape from each layer
-      Box layer_insert(insert_dim.x() / 2., insert_dim.y() / 2., layer_thickness / 2.);
-      SubtractionSolid layer_with_inserthole(
-          layer, layer_insert, Position(insert_local_pos.x(), insert_local_pos.y(), 0.));
-      Volume layer_vol(layer_name, layer_with_inserthole, air);
-
-      int slice_num  = 1;
-      double slice_z = -layer_thickness / 2.; // Keeps track of slices' z locations in each layer
-
-      // Looping over each layer's slices
-      for (xml_coll_t l(x_layer, _U(slice)); l; ++l) {
-        xml_comp_t x_slice     = l;
-        double slice_thickness = x_slice.thickness();
-        std::string slice_name = layer_name + _toString(slice_num, "slice%d");
-        Material slice_mat     = desc.material(x_slice.materialStr());
-        slice_z += slice_thickness / 2.; // Going to slice halfway point
-
-        Tube slice(rmin, rmax, slice_thickness / 2.);
-
-        // Removing insert shape from each slice
-        Box slice_insert(insert_dim.x() / 2., insert_dim.y() / 2., slice_thickness / 2.0);
-        SubtractionSolid slice_with_inserthole(
-            slice, slice_insert, Position(insert_local_pos.x(), insert_local_pos.y(), 0.));
-        Volume slice_vol(slice_name, slice_with_inserthole, slice_mat);
-
-        // Setting appropriate slices as sensitive
-        if (x_slice.isSensitive()) {
-          sens.setType("calorimeter");
-          slice_vol.setSensitiveDetector(sens);
-        }
-
-        // Setting slice attributes
-        slice_vol.setAttributes(desc, x_slice.regionStr(), x_slice.limitsStr(), x_slice.visStr());
-
-        // Placing slice within layer
-        pv = layer_vol.placeVolume(slice_vol,
-                                   Transform3D(RotationZYX(0, 0, 0), Position(0., 0., slice_z)));
-        pv.addPhysVolID("slice", slice_num);
-        slice_z += slice_thickness / 2.; // Going to end of slice
-        ++slice_num;
-      }
-
-      // Setting layer attributes
-      layer_vol.setAttributes(desc, x_layer.regionStr(), x_layer.limitsStr(), x_layer.visStr());
-
-      // Placing each layer inside the envelope volume
-      // layer_z starts as -length/2 (front of endcap)
-      // layer_z is increased by layer_thickness/2 at the start of the layer loop
-      // This moves to the middle of the layer (location of placement)
-      // It's then increased by layer_thickness/2 again to move to end of layer
-      pv = envelopeVol.placeVolume(layer_vol,
-                                   Transform3D(RotationZYX(0, 0, 0), Position(0., 0., layer_z)));
-      pv.addPhysVolID("layer", layer_num);
-      layer_num++;
-      layer_z += layer_thickness / 2.;
-    }
+    // The repeated layers of a section are identical: build the layer once, named after the
+    // first layer of the section
+    std::string layer_name = detName + _toString(layer_num, "_layer%d");
+    Tube layer(rmin, rmax, layer_thickness / 2.);
+
+    // Removing insert shape from each layer
+    Box layer_insert(insert_dim.x() / 2., insert_dim.y() / 2., layer_thickness / 2.);
+    SubtractionSolid layer_with_inserthole(
+        layer, layer_insert, Position(insert_local_pos.x(), insert_local_pos.y(), 0.));
+    epic::calorimeter::LayerType section;
+    section.volume = Volume(layer_name, layer_with_inserthole, air);
+
+    // Slices, with the insert shape removed from each of them
+    epic::calorimeter::buildSlices(
+        desc, section, x_layer, layer_thickness, sens, layer_name,
+        [&](double slice_thickness) -> Solid {
+          Tube slice(rmin, rmax, slice_thickness / 2.);
+          Box slice_insert(insert_dim.x() / 2., insert_dim.y() / 2., slice_thickness / 2.0);
+          return SubtractionSolid(slice, slice_insert,
+                                  Position(insert_local_pos.x(), insert_local_pos.y(), 0.));
+        });
+
+    // Setting layer attributes
+    section.volume.setAttributes(desc, x_layer.regionStr(), x_layer.limitsStr(), x_layer.visStr());
+    section.budget.name   = layer_name;
+    section.budget.repeat = repeat;
+    budgets.add(section.budget);
+
+    // Placing each layer inside the envelope volume
+    // layer_z starts as -length/2 (front of endcap), each layer is centered half a layer
+    // thickness after its front
+    epic::calorimeter::placeLayers(envelopeVol, section, repeat, layer_z + layer_thickness / 2.,
+                                   layer_thickness, layer_num);
+    layer_num += repeat;
+    layer_z += repeat * layer_thickness;
   }
 
   DetElement det(detName, detID);
@@ -126,7 +100,8 @@ static Ref_t createDetector(Detector& desc, xml_h handle, SensitiveDetector sens
   PlacedVolume phv = motherVol.placeVolume(envelopeVol, tr);
   phv.addPhysVolID("system", detID);
   det.setPlacement(phv);
+  budgets.report(det, "EndcapCalorimeterWithInsertCutout");
 
   return det;
 }
-DECLARE_DETELEMENT(epic_EndcapCalorimeterWithInsertCutout, createDetector)
+DECLARE_PROFILED_DETELEMENT(epic_EndcapCalorimeterWithInsertCutout, createDetector)
@@ -10,6 +10,7 @@
 #include "DD4hep/DetFactoryHelper.h"
 #include "TVector3.h"
 #include "XML/Layering.h"
+#include "ConstructionProfiler.h"
 
 static dd4hep::Ref_t create_detector(dd4hep::Detector& description, xml_h e,
                                      [[maybe_unused]] dd4hep::SensitiveDetector sens) {
@@ -67,4 +68,4 @@ static dd4hep::Ref_t create_detector(dd4hep::Detector& description, xml_h e,
   return sdet;
 }
 
-DECLARE_DETELEMENT(epic_EndcapFluxReturn, create_detector)
+DECLARE_PROFILED_DETELEMENT(epic_EndcapFluxReturn, create_detector)
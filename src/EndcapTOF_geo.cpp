@@ -19,6 +19,7 @@
 #include "XML/Utilities.h"
 #include <array>
 #include <map>
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -26,6 +27,7 @@ using namespace dd4hep::rec;
 using namespace dd4hep::detail;
 
 static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector sens) {
+  typedef vector<PlacedVolume> Placements;
   xml_det_t x_det      = e;
   int det_id           = x_det.id();
   std::string det_name = x_det.nameStr();
@@ -98,15 +100,108 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
     total_thickness += xml_comp_t(ci).thickness();
   }
 
+  // Front and back modules only differ in the order of their components, so each type is
+  // built once, with its sensitive surfaces, and placed at every accepted grid position.
+  map<string, Volume> modules;
+  map<string, Placements> sensitives;
+  map<string, std::vector<DD4hepDetectorHelper::SensorDescriptor>> sensor_descriptors;
+  map<string, xml_comp_t> module_types = {{"front", x_modFront}, {"back", x_modBack}};
+  double thickness_carbonsupp          = 0.0;
+  for (auto& [m_type, x_modCurr] : module_types) {
+    string m_nam = Form("%s_%s", x_modCurr.nameStr().c_str(), m_type.c_str());
+
+    int ncomponents = 0;
+    // the module assembly volume
+    Assembly m_vol(m_nam);
+    m_vol.setVisAttributes(description.visAttributes(x_modCurr.visStr()));
+
+    double thickness_so_far = 0.0;
+    double thickness_sum    = -total_thickness / 2.0;
+    for (xml_coll_t mci(x_modCurr, _U(module_component)); mci; ++mci, ++ncomponents) {
+      xml_comp_t x_comp  = mci;
+      xml_comp_t x_pos   = x_comp.position(false);
+      xml_comp_t x_rot   = x_comp.rotation(false);
+      const string c_nam = m_nam + _toString(ncomponents, "_component%d");
+      Box c_box(x_comp.width() / 2, x_comp.length() / 2, x_comp.thickness() / 2);
+      Volume c_vol(c_nam, c_box, description.material(x_comp.materialStr()));
+      if (x_comp.materialStr() == "CarbonFiber") {
+        thickness_carbonsupp = x_comp.thickness();
+      }
+      // Utility variable for the relative z-offset based off the previous components
+      const double zoff = thickness_sum + x_comp.thickness() / 2.0;
+      if (x_pos && x_rot) {
+        Position c_pos(x_pos.x(0), x_pos.y(0), x_pos.z(0) + zoff);
+        RotationZYX c_rot(x_rot.z(0), x_rot.y(0), x_rot.x(0));
+        pv = m_vol.placeVolume(c_vol, Transform3D(c_rot, c_pos));
+      } else if (x_rot) {
+        Position c_pos(0, 0, zoff);
+        pv = m_vol.placeVolume(
+            c_vol, Transform3D(RotationZYX(x_rot.z(0), x_rot.y(0), x_rot.x(0)), c_pos));
+      } else if (x_pos) {
+        pv = m_vol.placeVolume(c_vol, Position(x_pos.x(0), x_pos.y(0), x_pos.z(0) + zoff));
+      } else {
+        pv = m_vol.placeVolume(c_vol, Position(0, 0, zoff));
+      }
+      c_vol.setRegion(description, x_comp.regionStr());
+      c_vol.setLimitSet(description, x_comp.limitsStr());
+      c_vol.setVisAttributes(description, x_comp.visStr());
+      if (x_comp.isSensitive()) {
+        c_vol.setSensitiveDetector(sens);
+        sensitives[m_type].push_back(pv);
+        module_thicknesses[m_type] = {thickness_so_far + x_comp.thickness() / 2.0,
+                                      total_thickness - thickness_so_far -
+                                          x_comp.thickness() / 2.0};
+
+        // -------- create a measurement plane for the tracking surface attched to the sensitive volume -----
+        Vector3D u(-1., 0., 0.);
+        Vector3D v(0., -1., 0.);
+        Vector3D n(0., 0., 1.);
+
+        // compute the inner and outer thicknesses that need to be assigned to the tracking surface
+        // depending on wether the support is above or below the sensor
+        double inner_thickness = module_thicknesses[m_type][0];
+        double outer_thickness = module_thicknesses[m_type][1];
+
+        SurfaceType type(SurfaceType::Sensitive);
+
+        VolPlane surf(c_vol, type, inner_thickness, outer_thickness, u, v, n);
+        sensor_descriptors[m_type].emplace_back("XYZ", surf);
+
+        //--------------------------------------------
+      }
+      thickness_sum += x_comp.thickness();
+      thickness_so_far += x_comp.thickness();
+      // apply relative offsets in z-position used to stack components side-by-side
+      if (x_pos) {
+        thickness_sum += x_pos.z(0);
+        thickness_so_far += x_pos.z(0);
+      }
+    }
+    modules[m_type] = m_vol;
+  }
+
+  // support bar, shared by all modules
+  Box suppb_box((module_x + module_spacing) / 2, thickness_carbonsupp / 2,
+                x_supp_envelope.length() / 2);
+  Volume suppb_vol(det_name + "_suppbar", suppb_box, carbon);
+  suppb_vol.setVisAttributes(description, "AnlGray");
+
+  // grid of candidate module positions, 2 nx by 2 ny around the beam axis
+  int nx = 25;
+  int ny = 15;
+  if (x_layer.hasChild(_Unicode(xy_layout))) {
+    xml_comp_t x_xy_layout = x_layer.child(_Unicode(xy_layout));
+    nx                     = getAttrOrDefault<int>(x_xy_layout, _Unicode(nx), nx);
+    ny                     = getAttrOrDefault<int>(x_xy_layout, _Unicode(ny), ny);
+  }
+
   int module = 0;
-  int nx     = 25;
-  int ny     = 15;
   for (int ix = 0; ix < 2 * nx; ix++) {
     float xcoord = (ix - nx) * (module_x + module_spacing);
     for (int iy = 0; iy < 2 * ny; iy++) {
       float ycoord = (iy - ny) * (module_y - module_overlap);
       //! Note the module ordering is different for front and back side
-      xml_comp_t x_modCurr = iy % 2 == 0 ? x_modFront : x_modBack;
+      const string m_type = iy % 2 == 0 ? "front" : "back";
 
       double module_z = x_supp_envelope.length() / 2.0 + total_thickness / 2;
       if (iy % 2 == 0) {
@@ -129,103 +224,23 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
       string module_name = Form("module%d_%d_%d", module, ix, iy);
       DetElement mod_elt(lay_elt, module_name, module);
 
-      // create individual sensor layers here
-      string m_nam = Form("EndcapTOF_Module1_%d_%d", ix, iy);
-
-      int ncomponents = 0;
-      // the module assembly volume
-      Assembly m_vol(m_nam);
-      m_vol.setVisAttributes(description.visAttributes(x_modCurr.visStr()));
-
-      double thickness_so_far     = 0.0;
-      double thickness_sum        = -total_thickness / 2.0;
-      double thickness_carbonsupp = 0.0;
-      for (xml_coll_t mci(x_modCurr, _U(module_component)); mci; ++mci, ++ncomponents) {
-        xml_comp_t x_comp  = mci;
-        xml_comp_t x_pos   = x_comp.position(false);
-        xml_comp_t x_rot   = x_comp.rotation(false);
-        const string c_nam = Form("component_%d_%d", ix, iy);
-        Box c_box(x_comp.width() / 2, x_comp.length() / 2, x_comp.thickness() / 2);
-        Volume c_vol(c_nam, c_box, description.material(x_comp.materialStr()));
-        if (x_comp.materialStr() == "CarbonFiber") {
-          thickness_carbonsupp = x_comp.thickness();
-        }
-        // Utility variable for the relative z-offset based off the previous components
-        const double zoff = thickness_sum + x_comp.thickness() / 2.0;
-        if (x_pos && x_rot) {
-          Position c_pos(x_pos.x(0), x_pos.y(0), x_pos.z(0) + zoff);
-          RotationZYX c_rot(x_rot.z(0), x_rot.y(0), x_rot.x(0));
-          pv = m_vol.placeVolume(c_vol, Transform3D(c_rot, c_pos));
-        } else if (x_rot) {
-          Position c_pos(0, 0, zoff);
-          pv = m_vol.placeVolume(
-              c_vol, Transform3D(RotationZYX(x_rot.z(0), x_rot.y(0), x_rot.x(0)), c_pos));
-        } else if (x_pos) {
-          pv = m_vol.placeVolume(c_vol, Position(x_pos.x(0), x_pos.y(0), x_pos.z(0) + zoff));
-        } else {
-          pv = m_vol.placeVolume(c_vol, Position(0, 0, zoff));
-        }
-        c_vol.setRegion(description, x_comp.regionStr());
-        c_vol.setLimitSet(description, x_comp.limitsStr());
-        c_vol.setVisAttributes(description, x_comp.visStr());
-        if (x_comp.isSensitive()) {
-          pv.addPhysVolID("idx", ix);
-          pv.addPhysVolID("idy", iy);
-          c_vol.setSensitiveDetector(sens);
-          module_thicknesses[m_nam] = {thickness_so_far + x_comp.thickness() / 2.0,
-                                       total_thickness - thickness_so_far -
-                                           x_comp.thickness() / 2.0};
-
-          // -------- create a measurement plane for the tracking surface attched to the sensitive volume -----
-          Vector3D u(-1., 0., 0.);
-          Vector3D v(0., -1., 0.);
-          Vector3D n(0., 0., 1.);
-
-          // compute the inner and outer thicknesses that need to be assigned to the tracking surface
-          // depending on wether the support is above or below the sensor
-          double inner_thickness = module_thicknesses[m_nam][0];
-          double outer_thickness = module_thicknesses[m_nam][1];
-
-          SurfaceType type(SurfaceType::Sensitive);
-
-          VolPlane surf(c_vol, type, inner_thickness, outer_thickness, u, v, n);
-
-          DetElement comp_de(mod_elt, std::string("de_") + pv.volume().name(), module);
-          comp_de.setPlacement(pv);
-
-          auto& comp_de_params =
-              DD4hepDetectorHelper::ensureExtension<dd4hep::rec::VariantParameters>(comp_de);
-          comp_de_params.set<string>("axis_definitions", "XYZ");
-          volSurfaceList(comp_de)->push_back(surf);
-
-          //--------------------------------------------
-        }
-        thickness_sum += x_comp.thickness();
-        thickness_so_far += x_comp.thickness();
-        // apply relative offsets in z-position used to stack components side-by-side
-        if (x_pos) {
-          thickness_sum += x_pos.z(0);
-          thickness_so_far += x_pos.z(0);
-        }
-      }
-
-      const string suppb_nam =
-          Form("suppbar_%d_%d", ix, iy); //_toString(ncomponents, "component%d");
-      Box suppb_box((module_x + module_spacing) / 2, thickness_carbonsupp / 2,
-                    x_supp_envelope.length() / 2);
-      Volume suppb_vol(suppb_nam, suppb_box, carbon);
       Transform3D trsupp(RotationZYX(0, 0, 0),
                          Position(xcoord, ycoord + module_y / 2 - module_overlap / 2, 0));
-      suppb_vol.setVisAttributes(description, "AnlGray");
-
       pv = lay_vol.placeVolume(suppb_vol, trsupp);
-      // module built!
 
       Transform3D tr(RotationZYX(M_PI / 2, 0, 0), Position(xcoord, ycoord, module_z));
-
-      pv = lay_vol.placeVolume(m_vol, tr);
-      pv.addPhysVolID("module", module);
+      pv = lay_vol.placeVolume(modules[m_type], tr);
+      pv.addPhysVolID("module", module).addPhysVolID("idx", ix).addPhysVolID("idy", iy);
       mod_elt.setPlacement(pv);
+
+      // sensor DetElements share the placements and surfaces of their module type
+      Placements& sensVols = sensitives[m_type];
+      for (size_t ic = 0; ic < sensVols.size(); ++ic) {
+        PlacedVolume sens_pv = sensVols[ic];
+        DetElement comp_de(mod_elt, std::string("de_") + sens_pv.volume().name(), module);
+        comp_de.setPlacement(sens_pv);
+        sensor_descriptors[m_type][ic].attach(comp_de);
+      }
     }
   }
 
@@ -245,4 +260,4 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
 
 //@}
 // clang-format off
-DECLARE_DETELEMENT(epic_TOFEndcap, create_detector)
+DECLARE_PROFILED_DETELEMENT(epic_TOFEndcap, create_detector)
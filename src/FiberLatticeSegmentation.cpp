@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 ePIC Collaboration
+
+//==========================================================================
+//  Virtual fiber lattice segmentation
+//
+//  Readout for homogenized fiber calorimeters, see FiberLatticeSegmentation.h
+//--------------------------------------------------------------------------
+
+#include <DD4hep/Factories.h>
+#include <DD4hep/detail/SegmentationsInterna.h>
+
+#include <cmath>
+
+#include "FiberLatticeSegmentation.h"
+
+using dd4hep::DDSegmentation::CellID;
+using dd4hep::DDSegmentation::SegmentationParameter;
+using dd4hep::DDSegmentation::Vector3D;
+using dd4hep::DDSegmentation::VolumeID;
+
+namespace epic {
+
+FiberLattice::FiberLattice(const std::string& cellEncoding) : Segmentation(cellEncoding) {
+  init();
+}
+
+FiberLattice::FiberLattice(const dd4hep::DDSegmentation::BitFieldCoder* decoder)
+    : Segmentation(decoder) {
+  init();
+}
+
+void FiberLattice::init() {
+  _type        = "FiberLattice";
+  _description = "Nearest fiber of a staggered fiber lattice in the local x-y plane";
+
+  registerParameter("pitch_x", "Fiber pitch along x", _pitchX, 0.,
+                    SegmentationParameter::LengthUnit, true);
+  registerParameter("pitch_y", "Row pitch along y", _pitchY, 0., SegmentationParameter::LengthUnit,
+                    true);
+  registerParameter("offset_x", "Fiber x in even rows", _offsetX, 0.,
+                    SegmentationParameter::LengthUnit, true);
+  registerParameter("offset_y", "Fiber y in row 0", _offsetY, 0.,
+                    SegmentationParameter::LengthUnit, true);
+  registerParameter("odd_row_shift_x", "Extra x shift of odd rows", _oddRowShiftX, 0.,
+                    SegmentationParameter::LengthUnit, true);
+  registerParameter("strip_size_z", "Strip size along the fibers, 0 for none", _stripSizeZ, 0.,
+                    SegmentationParameter::LengthUnit, true);
+  registerParameter("index_offset", "Offset added to the fiber indices", _indexOffset, 0,
+                    SegmentationParameter::NoUnit, true);
+  registerIdentifier("identifier_x", "Cell ID identifier for the fiber column", _xId, "fiber_x");
+  registerIdentifier("identifier_y", "Cell ID identifier for the fiber row", _yId, "fiber_y");
+  registerIdentifier("identifier_z", "Cell ID identifier for the strip along the fibers", _zId,
+                     "z");
+}
+
+Vector3D FiberLattice::position(const CellID& cID) const {
+  const long iy = _decoder->get(cID, _yId) - _indexOffset;
+  const long ix = _decoder->get(cID, _xId) - _indexOffset;
+  Vector3D pos;
+  pos.Y = _offsetY + iy * _pitchY;
+  pos.X = _offsetX + ix * _pitchX + (iy % 2 != 0 ? _oddRowShiftX : 0.);
+  pos.Z = _stripSizeZ > 0. ? _decoder->get(cID, _zId) * _stripSizeZ : 0.;
+  return pos;
+}
+
+CellID FiberLattice::cellID(const Vector3D& localPosition, const Vector3D& /* globalPosition */,
+                            const VolumeID& vID) const {
+  const long iy = std::lround((localPosition.Y - _offsetY) / _pitchY);
+  const long ix =
+      std::lround((localPosition.X - _offsetX - (iy % 2 != 0 ? _oddRowShiftX : 0.)) / _pitchX);
+  CellID cID = vID;
+  _decoder->set(cID, _xId, ix + _indexOffset);
+  _decoder->set(cID, _yId, iy + _indexOffset);
+  if (_stripSizeZ > 0.) {
+    _decoder->set(cID, _zId, static_cast<long>(std::floor(localPosition.Z / _stripSizeZ + 0.5)));
+  }
+  return cID;
+}
+
+std::vector<double> FiberLattice::cellDimensions(const CellID& /* cID */) const {
+  return {_pitchX, _pitchY, _stripSizeZ};
+}
+
+} // namespace epic
+
+namespace {
+template <typename T>
+dd4hep::SegmentationObject* create_segmentation(const dd4hep::BitFieldCoder* decoder) {
+  return new dd4hep::SegmentationWrapper<T>(decoder);
+}
+} // namespace
+
+DECLARE_SEGMENTATION(FiberLattice, create_segmentation<epic::FiberLattice>)
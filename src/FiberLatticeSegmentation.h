@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 ePIC Collaboration
+
+#pragma once
+
+#include <DDSegmentation/Segmentation.h>
+
+#include <string>
+#include <vector>
+
+namespace epic {
+
+// Virtual fiber readout for homogenized fiber calorimeters
+//
+// Maps a hit position in the local frame of a homogenized (fiber + absorber mixture) volume
+// onto the nearest fiber of a staggered lattice in the local x-y plane, with fibers along z:
+//
+//   row    iy = round((y - offset_y) / pitch_y)
+//   column ix = round((x - offset_x - shift) / pitch_x), shift = odd_row_shift_x for odd rows
+//
+// and stores `ix + index_offset` and `iy + index_offset` in the x and y identifiers. With a
+// non-zero strip_size_z, the position along the fibers is also binned into the z identifier.
+// The builders that use this segmentation set the lattice from their own fiber layout.
+class FiberLattice : public dd4hep::DDSegmentation::Segmentation {
+public:
+  explicit FiberLattice(const std::string& cellEncoding = "");
+  explicit FiberLattice(const dd4hep::DDSegmentation::BitFieldCoder* decoder);
+  ~FiberLattice() override = default;
+
+  dd4hep::DDSegmentation::Vector3D
+  position(const dd4hep::DDSegmentation::CellID& cID) const override;
+  dd4hep::DDSegmentation::CellID cellID(const dd4hep::DDSegmentation::Vector3D& localPosition,
+                                        const dd4hep::DDSegmentation::Vector3D& globalPosition,
+                                        const dd4hep::DDSegmentation::VolumeID& vID) const override;
+  std::vector<double> cellDimensions(const dd4hep::DDSegmentation::CellID& cID) const override;
+
+  void setLattice(double pitch_x, double pitch_y, double offset_x, double offset_y,
+                  double odd_row_shift_x, int index_offset) {
+    _pitchX       = pitch_x;
+    _pitchY       = pitch_y;
+    _offsetX      = offset_x;
+    _offsetY      = offset_y;
+    _oddRowShiftX = odd_row_shift_x;
+    _indexOffset  = index_offset;
+  }
+
+private:
+  void init();
+
+  double _pitchX       = 0.;
+  double _pitchY       = 0.;
+  double _offsetX      = 0.;
+  double _offsetY      = 0.;
+  double _oddRowShiftX = 0.;
+  double _stripSizeZ   = 0.;
+  int _indexOffset     = 0;
+  std::string _xId, _yId, _zId;
+};
+
+} // namespace epic
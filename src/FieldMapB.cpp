@@ -16,7 +16,9 @@
 #include <tuple>
 namespace fs = std::filesystem;
 
+#include "DetectorSelection.h"
 #include "FileLoaderHelper.h"
+#include "ConstructionProfiler.h"
 
 using namespace dd4hep;
 
@@ -286,6 +288,18 @@ static Ref_t create_field_map_b(Detector& /*lcdd*/, xml::Handle_t handle) {
   CartesianField field;
   std::string field_type = x_par.attr<std::string>(_Unicode(field_type));
 
+  // fields listed in IGNORED_FIELDS are replaced by a zero field without loading the map
+  if (DetectorSelection::isFieldIgnored(x_par.nameStr())) {
+    printout(WARNING, "FieldMapB",
+             "field " + x_par.nameStr() + " is in IGNORED_FIELDS, using zero field");
+    auto zero = new ConstantField();
+    zero->field_type =
+        (field_type == "electric") ? CartesianField::ELECTRIC : CartesianField::MAGNETIC;
+    zero->direction = Direction(0., 0., 0.);
+    field.assign(zero, x_par.nameStr(), "ConstantField");
+    return field;
+  }
+
   std::string coord_type = x_par.attr<std::string>(_Unicode(coord_type));
 
   // dimensions
@@ -345,4 +359,4 @@ static Ref_t create_field_map_b(Detector& /*lcdd*/, xml::Handle_t handle) {
   return field;
 }
 
-DECLARE_XMLELEMENT(epic_FieldMapB, create_field_map_b)
+DECLARE_PROFILED_XMLELEMENT(epic_FieldMapB, create_field_map_b)
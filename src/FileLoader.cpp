@@ -9,11 +9,14 @@
 
 #include <fmt/core.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <filesystem>
 #include <iostream>
 #include <string>
+#include <vector>
 
+#include "DetectorSelection.h"
 #include "FileLoaderHelper.h"
 
 using namespace dd4hep;
@@ -25,6 +28,7 @@ void usage(int argc, char** argv) {
          "     file:<string>            file location                                        \n"
          "     url:<string>             url location                                         \n"
          "     cmd:<string>             download command with {0} for url, {1} for output    \n"
+         "     detector:<string>        skip unless this detector is selected (repeatable)   \n"
          "\tArguments given: "
       << arguments(argc, argv) << std::endl;
   std::exit(EINVAL);
@@ -34,6 +38,7 @@ void usage(int argc, char** argv) {
 long load_file(Detector& /* desc */, int argc, char** argv) {
   // argument parsing
   std::string cache, file, url;
+  std::vector<std::string> detectors;
   for (int i = 0; i < argc && argv[i]; ++i) {
     if (0 == std::strncmp("cache:", argv[i], 6))
       cache = (argv[i] + 6);
@@ -41,6 +46,8 @@ long load_file(Detector& /* desc */, int argc, char** argv) {
       file = (argv[i] + 5);
     else if (0 == std::strncmp("url:", argv[i], 4))
       url = (argv[i] + 4);
+    else if (0 == std::strncmp("detector:", argv[i], 9))
+      detectors.push_back(argv[i] + 9);
     else {
       std::cerr << "Unexpected argument \"" << argv[i] << "\"" << std::endl;
       usage(argc, argv);
@@ -50,6 +57,14 @@ long load_file(Detector& /* desc */, int argc, char** argv) {
   printout(DEBUG, "FileLoader", "arg file: " + file);
   printout(DEBUG, "FileLoader", "arg url: " + url);
 
+  // skip files only needed by detectors that are not built
+  if (!detectors.empty() &&
+      std::none_of(detectors.begin(), detectors.end(),
+                   [](const std::string& det) { return DetectorSelection::isSelected(det); })) {
+    printout(INFO, "FileLoader", "skipping " + file + ", no required detector is selected");
+    return 1;
+  }
+
   // if file or url is empty, do nothing
   if (file.empty()) {
     printout(WARNING, "FileLoader", "no file specified");
@@ -3,13 +3,13 @@
 
 #include "DD4hep/DetFactoryHelper.h"
 #include <map>
+#include "ConstructionProfiler.h"
+#include "TrackerModuleBuilder.h"
 
 using namespace std;
 using namespace dd4hep;
 using namespace dd4hep::detail;
 
-using Placements = vector<PlacedVolume>;
-
 static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector sens) {
   xml_det_t x_det = e;
   // Material air = description.air();
@@ -23,22 +23,19 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
 
   PlacedVolume pv;
 
-  map<string, Volume> modules;
-  map<string, Placements> sensitives;
+  map<string, epic::tracker::ModuleType> module_types;
   map<string, Volume> module_assemblies;
 
   int m_id = 0;
   // mi ~ module iterator
   for (xml_coll_t mi(x_det, _U(module)); mi; ++mi, ++m_id) {
-    xml_comp_t x_mod           = mi;
-    string m_nam               = x_mod.nameStr();
-    double mod_width           = getAttrOrDefault<double>(x_mod, _U(width), 3.2 * cm);
-    double mod_height          = getAttrOrDefault<double>(x_mod, _U(height), 3.2 * cm);
-    double mod_total_thickness = 0.;
-
-    xml_coll_t ci(x_mod, _U(module_component));
-    for (ci.reset(), mod_total_thickness = 0.0; ci; ++ci)
-      mod_total_thickness += xml_comp_t(ci).thickness();
+    xml_comp_t x_mod                    = mi;
+    string m_nam                        = x_mod.nameStr();
+    double mod_width                    = getAttrOrDefault<double>(x_mod, _U(width), 3.2 * cm);
+    double mod_height                   = getAttrOrDefault<double>(x_mod, _U(height), 3.2 * cm);
+    epic::tracker::ModuleStack stack    = epic::tracker::stackComponents(x_mod);
+    double mod_total_thickness          = stack.total_thickness;
+    epic::tracker::ModuleType& mod_type = module_types[m_nam];
 
     Box m_solid(mod_width / 2.0, mod_height / 2.0, mod_total_thickness / 2.0);
     Volume m_volume(m_nam, m_solid, vacuum);
@@ -46,11 +43,10 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
     //m_volume.setVisAttributes(description.visAttributes(x_mod.visStr()));
     m_volume.setVisAttributes(description.visAttributes("AnlGold"));
 
-    double comp_z_pos = -mod_total_thickness / 2.0;
-    int n_sensor      = 1;
-    int c_id;
-    for (ci.reset(), n_sensor = 1, c_id = 0; ci; ++ci, ++c_id) {
-      xml_comp_t c   = ci;
+    int n_sensor = 1;
+    int c_id     = 0;
+    for (auto& comp : stack.components) {
+      xml_comp_t c   = comp.x_comp;
       double c_thick = c.thickness();
       double comp_x  = getAttrOrDefault<double>(c, _Unicode(width), mod_width);
       double comp_y  = getAttrOrDefault<double>(c, _Unicode(height), mod_height);
@@ -63,7 +59,7 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
       Volume c_vol(c_name, comp_shape, c_mat);
       c_vol.setVisAttributes(description.visAttributes(c.visStr()));
 
-      Position c_position(0, 0.0, comp_z_pos + c_thick / 2.0);
+      Position c_position(0, 0.0, comp.center);
       if (c.hasChild(_U(position))) {
         xml_comp_t c_pos = c.child(_U(position));
         c_position       = Position(c_pos.x(), c_pos.y(), c_pos.z());
@@ -74,14 +70,17 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
         // " Max of 2 modules allowed!");
         pv.addPhysVolID("sensor", n_sensor);
         c_vol.setSensitiveDetector(sens);
-        sensitives[m_nam].push_back(pv);
+        mod_type.sensors.push_back(pv);
         ++n_sensor;
       }
-      comp_z_pos += c_thick;
+      ++c_id;
     }
-    modules[m_nam] = m_volume;
+    mod_type.volume = m_volume;
   }
 
+  // arrays with the same layout share one placement plan
+  epic::tracker::PlacementCache<epic::tracker::ArrayLayout> array_plans;
+
   std::map<std::string, DetElement> module_assembly_delements;
   // module assemblies
   for (xml_coll_t ma(x_det, _Unicode(module_assembly)); ma; ++ma) {
@@ -95,47 +94,31 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
     int i_mod = 0;
     // array of modules
     for (xml_coll_t ai(x_ma, _Unicode(array)); ai; ++ai) {
-      xml_comp_t x_array     = ai;
-      double nx              = getAttrOrDefault<double>(x_array, _Unicode(nx), 1);
-      double ny              = getAttrOrDefault<double>(x_array, _Unicode(ny), 1);
-      double dz              = getAttrOrDefault<double>(x_array, _Unicode(dz), 0 * mm);
-      double arr_width       = getAttrOrDefault<double>(x_array, _Unicode(width), 3.2 * cm);
-      double arr_height      = getAttrOrDefault<double>(x_array, _Unicode(height), 3.2 * cm);
+      xml_comp_t x_array = ai;
+      epic::tracker::ArrayLayout layout;
+      layout.nx              = getAttrOrDefault<int>(x_array, _Unicode(nx), 1);
+      layout.ny              = getAttrOrDefault<int>(x_array, _Unicode(ny), 1);
+      layout.z               = getAttrOrDefault<double>(x_array, _Unicode(dz), 0 * mm);
+      layout.width           = getAttrOrDefault<double>(x_array, _Unicode(width), 3.2 * cm);
+      layout.height          = getAttrOrDefault<double>(x_array, _Unicode(height), 3.2 * cm);
       std::string arr_module = getAttrOrDefault<std::string>(x_array, _Unicode(module), "");
       // TODO: add check here
-      auto arr_vol         = modules[arr_module];
-      Placements& sensVols = sensitives[arr_module];
-
-      double arr_x_delta = arr_width / double(nx);
-      double arr_y_delta = arr_height / double(ny);
+      const epic::tracker::ModuleType& mod_type = module_types[arr_module];
 
       xml_comp_t x_pos = x_array.position(false);
+      if (x_pos) {
+        layout.x = x_pos.x(0);
+        layout.y = x_pos.y(0);
+        layout.z += x_pos.z(0);
+      }
 
-      for (int ix = 0; ix < nx; ix++) {
-        for (int iy = 0; iy < ny; iy++) {
-          double z_pos = dz; //(ix%2)? dz : -dz;
-          i_mod++;
-          Position arr_pos(-arr_width / 2.0 + arr_x_delta / 2.0 + ix * arr_x_delta,
-                           -arr_height / 2.0 + arr_y_delta / 2.0 + iy * arr_y_delta, z_pos);
-          if (x_pos) {
-            arr_pos += Position(x_pos.x(0), x_pos.y(0), x_pos.z(0));
-          }
-          DetElement mod_de(ma_de, ma_name + std::string("_mod") + std::to_string(i_mod), i_mod);
-          pv = ma_vol.placeVolume(arr_vol, arr_pos);
-          pv.addPhysVolID("module", i_mod);
-          mod_de.setPlacement(pv);
-          for (size_t ic = 0; ic < sensVols.size(); ++ic) {
-            PlacedVolume sens_pv = sensVols[ic];
-            DetElement comp_de(mod_de, std::string("de_") + sens_pv.volume().name(), ic + 1);
-            comp_de.setPlacement(sens_pv);
-            // Acts::ActsExtension* sensorExtension = new Acts::ActsExtension();
-            //// sensorExtension->addType("sensor", "detector");
-            // comp_de.addExtension<Acts::ActsExtension>(sensorExtension);
-            //// comp_de.setAttributes(description, sens_pv.volume(),
-            /// x_layer.regionStr(), / x_layer.limitsStr(), /
-            /// xml_det_t(xmleles[m_nam]).visStr());
-          }
-        }
+      for (auto& tr : array_plans.plan(layout)) {
+        i_mod++;
+        DetElement mod_de(ma_de, ma_name + std::string("_mod") + std::to_string(i_mod), i_mod);
+        pv = ma_vol.placeVolume(mod_type.volume, tr);
+        pv.addPhysVolID("module", i_mod);
+        mod_de.setPlacement(pv);
+        epic::tracker::addSensorElements(mod_de, mod_type, "de_", 0, true);
       }
     }
   }
@@ -200,4 +183,4 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
   return sdet;
 }
 
-DECLARE_DETELEMENT(ip6_ForwardRomanPot, create_detector)
+DECLARE_PROFILED_DETELEMENT(ip6_ForwardRomanPot, create_detector)
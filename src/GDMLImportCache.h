@@ -0,0 +1,245 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 ePIC Collaboration
+
+#pragma once
+
+#include <DD4hep/DetFactoryHelper.h>
+#include <DD4hep/Printout.h>
+
+#include <TGDMLParse.h>
+#include <TGeoTessellated.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+// Binary cache of tessellated solids imported from GDML
+//
+// Files fetched with `EnsureFileFromURLExists` are symlinks to a file named by the hash
+// of their URL. The first import of such a file parses the GDML, closes the tessellated
+// mesh, and writes the closed mesh (unique vertices and facet indices) next to it as
+// `<hash>.tess`. Later imports read that file instead, so that both the XML parsing and
+// the vertex merging and facet checks of `CloseShape` are skipped. The cache file holds a
+// hash of the GDML content and of its own payload, and is only used if both match. Files
+// that are not symlinks to a hash fall back to a plain GDML import, and read-only cache
+// locations are not written.
+namespace GDMLImportCache {
+
+static constexpr std::uint32_t kMagic   = 0x53534554; // "TESS"
+static constexpr std::uint32_t kVersion = 2;
+
+// 64-bit FNV-1a hash of a byte string
+inline std::uint64_t Hash(const std::string& bytes) {
+  std::uint64_t hash = 0xcbf29ce484222325ULL;
+  for (unsigned char c : bytes) {
+    hash = (hash ^ c) * 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+// content hash of a GDML file
+inline std::uint64_t FileHash(const std::string& file) {
+  std::ifstream in(file, std::ios::binary);
+  std::ostringstream content;
+  content << in.rdbuf();
+  return Hash(content.str());
+}
+
+// cache file of a GDML file, or empty if it is not keyed by a hash
+inline std::filesystem::path CachePath(const std::string& file) {
+  namespace fs = std::filesystem;
+  fs::path file_path(file);
+  if (!fs::is_symlink(file_path)) {
+    return {};
+  }
+  return file_path.parent_path() / (fs::read_symlink(file_path).filename().string() + ".tess");
+}
+
+// whether a cache file can be created next to the GDML file
+inline bool Writable(const std::filesystem::path& path) {
+  return ::access(path.parent_path().c_str(), W_OK) == 0;
+}
+
+template <typename T> void WriteValue(std::ostream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T> bool ReadValue(std::istream& in, T& value) {
+  return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+inline void WriteString(std::ostream& out, const std::string& str) {
+  std::uint32_t size = str.size();
+  WriteValue(out, size);
+  out.write(str.data(), size);
+}
+
+inline bool ReadString(std::istream& in, std::string& str) {
+  std::uint32_t size = 0;
+  if (!ReadValue(in, size)) {
+    return false;
+  }
+  str.resize(size);
+  return static_cast<bool>(in.read(str.data(), size));
+}
+
+inline bool Write(const std::filesystem::path& path, dd4hep::Volume vol, std::uint64_t gdml_hash) {
+  dd4hep::TessellatedSolid solid = vol.solid();
+  std::ostringstream payload;
+  WriteString(payload, vol.name());
+  WriteString(payload, solid.name());
+  WriteValue(payload, std::uint32_t(solid.num_vertex()));
+  for (int i = 0; i < solid.num_vertex(); ++i) {
+    const auto& vertex = solid.vertex(i);
+    double xyz[3]      = {vertex[0], vertex[1], vertex[2]};
+    WriteValue(payload, xyz);
+  }
+  WriteValue(payload, std::uint32_t(solid.num_facet()));
+  for (int i = 0; i < solid.num_facet(); ++i) {
+    const auto& facet = solid.facet(i);
+    WriteValue(payload, std::int32_t(facet.GetNvert()));
+    for (int j = 0; j < facet.GetNvert(); ++j) {
+      WriteValue(payload, std::int32_t(facet[j]));
+    }
+  }
+  std::ostringstream content;
+  WriteValue(content, kMagic);
+  WriteValue(content, kVersion);
+  WriteValue(content, gdml_hash);
+  WriteValue(content, Hash(payload.str()));
+  content << payload.str();
+  const std::string bytes = content.str();
+
+  // write to a unique temporary file first, so that concurrent writers never share a file
+  // and readers never see a partial one
+  std::string tmp_path = path.string() + ".XXXXXX";
+  const int fd         = ::mkstemp(tmp_path.data());
+  if (fd < 0) {
+    return false;
+  }
+  std::size_t written = 0;
+  while (written < bytes.size()) {
+    const ssize_t n = ::write(fd, bytes.data() + written, bytes.size() - written);
+    if (n <= 0) {
+      break;
+    }
+    written += n;
+  }
+  const bool closed = ::close(fd) == 0;
+  std::error_code ec;
+  if (written == bytes.size() && closed) {
+    std::filesystem::rename(tmp_path, path, ec);
+    if (!ec) {
+      return true;
+    }
+  }
+  std::filesystem::remove(tmp_path, ec);
+  return false;
+}
+
+inline dd4hep::Volume Read(const std::filesystem::path& path, std::uint64_t gdml_hash,
+                           dd4hep::Material material) {
+  std::ifstream file(path, std::ios::binary);
+  std::ostringstream content;
+  content << file.rdbuf();
+  std::istringstream in(content.str());
+  std::uint32_t magic = 0, version = 0;
+  std::uint64_t hash = 0, payload_hash = 0;
+  if (!ReadValue(in, magic) || magic != kMagic || !ReadValue(in, version) ||
+      version != kVersion || !ReadValue(in, hash) || hash != gdml_hash ||
+      !ReadValue(in, payload_hash) ||
+      payload_hash != Hash(content.str().substr(static_cast<std::size_t>(in.tellg())))) {
+    return {};
+  }
+  std::string vol_name, solid_name;
+  std::uint32_t nvertices = 0, nfacets = 0;
+  if (!ReadString(in, vol_name) || !ReadString(in, solid_name) || !ReadValue(in, nvertices)) {
+    return {};
+  }
+  std::vector<dd4hep::TessellatedSolid::Vertex> vertices;
+  vertices.reserve(nvertices);
+  for (std::uint32_t i = 0; i < nvertices; ++i) {
+    double xyz[3];
+    if (!ReadValue(in, xyz)) {
+      return {};
+    }
+    vertices.emplace_back(xyz[0], xyz[1], xyz[2]);
+  }
+  if (!ReadValue(in, nfacets)) {
+    return {};
+  }
+  // facets refer to the (already unique) vertices by index
+  dd4hep::TessellatedSolid solid(solid_name, vertices);
+  for (std::uint32_t i = 0; i < nfacets; ++i) {
+    std::int32_t nvert = 0, index[4];
+    if (!ReadValue(in, nvert) || nvert < 3 || nvert > 4 ||
+        !in.read(reinterpret_cast<char*>(index), nvert * sizeof(std::int32_t))) {
+      return {};
+    }
+    for (int j = 0; j < nvert; ++j) {
+      if (index[j] < 0 || static_cast<std::uint32_t>(index[j]) >= nvertices) {
+        return {};
+      }
+    }
+    if (nvert == 3) {
+      solid.addFacet(index[0], index[1], index[2]);
+    } else {
+      solid.addFacet(index[0], index[1], index[2], index[3]);
+    }
+  }
+  // the mesh was checked when the cache was written, only the bounding box is needed
+  solid->CloseShape(false, false, false);
+  return dd4hep::Volume(vol_name, solid, material);
+}
+
+} // namespace GDMLImportCache
+
+// Import a GDML file holding a single tessellated volume, and return it with a closed mesh
+// and the given material. Returns an invalid volume if the GDML parser fails.
+inline dd4hep::Volume ImportTessellatedGDML(TGDMLParse& parser, const std::string& file,
+                                            dd4hep::Material material, bool use_cache = true) {
+  namespace fs            = std::filesystem;
+  fs::path cache_path     = use_cache ? GDMLImportCache::CachePath(file) : fs::path();
+  std::uint64_t gdml_hash = cache_path.empty() ? 0 : GDMLImportCache::FileHash(file);
+  if (!cache_path.empty() && fs::exists(cache_path)) {
+    dd4hep::Volume vol = GDMLImportCache::Read(cache_path, gdml_hash, material);
+    if (vol.isValid()) {
+      dd4hep::printout(dd4hep::DEBUG, "GDMLImportCache", "%s read from %s", file.c_str(),
+                       cache_path.c_str());
+      return vol;
+    }
+    dd4hep::printout(dd4hep::WARNING, "GDMLImportCache", "ignoring invalid cache %s",
+                     cache_path.c_str());
+  }
+
+  dd4hep::Volume vol = parser.GDMLReadFile(file.c_str());
+  if (!vol.isValid()) {
+    return vol;
+  }
+  vol.import();
+  dd4hep::TessellatedSolid solid = vol.solid();
+  solid->CloseShape(true, true, true); // tesselated solid not closed by import!
+  vol.setMaterial(material);
+
+  if (cache_path.empty()) {
+    return vol;
+  }
+  if (!GDMLImportCache::Writable(cache_path)) {
+    // e.g. an installed tree, imports keep parsing the GDML
+    dd4hep::printout(dd4hep::DEBUG, "GDMLImportCache", "not caching %s, %s is read-only",
+                     file.c_str(), cache_path.parent_path().c_str());
+  } else if (GDMLImportCache::Write(cache_path, vol, gdml_hash)) {
+    dd4hep::printout(dd4hep::INFO, "GDMLImportCache", "%s cached as %s", file.c_str(),
+                     cache_path.c_str());
+  } else {
+    dd4hep::printout(dd4hep::WARNING, "GDMLImportCache", "unable to write cache %s",
+                     cache_path.c_str());
+  }
+  return vol;
+}
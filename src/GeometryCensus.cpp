@@ -0,0 +1,267 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 ePIC Collaboration
+
+//==========================================================================
+//  Geometry complexity census
+//
+//  Walks the constructed world and counts, per top-level DetElement, the
+//  quantities that drive Geant4 initialization time and memory. Optionally
+//  compares them against a threshold file with lines of the form
+//    <detector|*> <metric> <maximum>
+//  and exits with failure when any threshold is exceeded.
+//--------------------------------------------------------------------------
+
+#include <DD4hep/DetFactoryHelper.h>
+#include <DD4hep/Factories.h>
+#include <DD4hep/OpticalSurfaceManager.h>
+#include <DD4hep/Printout.h>
+#include <DD4hep/detail/OpticalSurfaceManagerInterna.h>
+#include <DDRec/DetectorData.h>
+
+#include <TGeoBoolNode.h>
+#include <TGeoCompositeShape.h>
+#include <TGeoTessellated.h>
+#include <TGeoVolume.h>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+
+using namespace dd4hep;
+
+namespace {
+
+// metrics in report order
+const std::array<std::string, 10> kMetrics{
+    "volumes", "nodes",       "placements", "booleans",      "boolean_depth",
+    "facets",  "detelements", "parameters", "skin_surfaces", "border_surfaces"};
+
+using Census = std::map<std::string, long>;
+
+// depth of a boolean tree, 0 for primitive shapes
+long boolean_depth(const TGeoShape* shape) {
+  auto* composite = dynamic_cast<const TGeoCompositeShape*>(shape);
+  if (composite == nullptr || composite->GetBoolNode() == nullptr) {
+    return 0;
+  }
+  const TGeoBoolNode* node = composite->GetBoolNode();
+  return 1 + std::max(boolean_depth(node->GetLeftShape()), boolean_depth(node->GetRightShape()));
+}
+
+class VolumeWalker {
+public:
+  explicit VolumeWalker(Census& census) : m_census(census) {}
+
+  // returns the number of physical placements below vol (memoized per volume)
+  long walk(TGeoVolume* vol) {
+    if (auto it = m_placements.find(vol); it != m_placements.end()) {
+      return it->second;
+    }
+    m_census["volumes"] += 1;
+    m_census["nodes"] += vol->GetNdaughters();
+    if (const long depth = boolean_depth(vol->GetShape()); depth > 0) {
+      m_census["booleans"] += 1;
+      m_census["boolean_depth"] = std::max(m_census["boolean_depth"], depth);
+    }
+    if (auto* tess = dynamic_cast<const TGeoTessellated*>(vol->GetShape())) {
+      m_census["facets"] += tess->GetNfacets();
+    }
+    long placements = 0;
+    for (int i = 0; i < vol->GetNdaughters(); ++i) {
+      placements += 1 + walk(vol->GetNode(i)->GetVolume());
+    }
+    m_placements[vol] = placements;
+    return placements;
+  }
+
+private:
+  Census& m_census;
+  std::map<const TGeoVolume*, long> m_placements;
+};
+
+void count_detelements(DetElement det, Census& census) {
+  census["detelements"] += 1;
+  if (auto* params = det.extension<rec::VariantParameters>(false)) {
+    census["parameters"] += params->variantParameters.size();
+  }
+  for (const auto& [name, child] : det.children()) {
+    count_detelements(child, census);
+  }
+}
+
+// name of the top-level detector that contains det
+std::string top_level_name(DetElement det, DetElement world) {
+  while (det.isValid() && det.parent().isValid() && det.parent().ptr() != world.ptr()) {
+    det = det.parent();
+  }
+  return det.isValid() ? det.name() : "";
+}
+
+std::map<std::string, Census> take_census(Detector& desc) {
+  std::map<std::string, Census> result;
+  DetElement world = desc.world();
+  for (const auto& [name, det] : world.children()) {
+    Census& census = result[name];
+    for (const auto& metric : kMetrics) {
+      census[metric] = 0;
+    }
+    if (det.placement().isValid()) {
+      VolumeWalker walker(census);
+      census["placements"] = 1 + walker.walk(det.placement().volume().ptr());
+    }
+    count_detelements(det, census);
+  }
+
+  OpticalSurfaceManager surfaces = desc.surfaceManager();
+  for (const auto& [key, skin] : surfaces->skinSurfaces) {
+    if (auto it = result.find(top_level_name(key.first, world)); it != result.end()) {
+      it->second["skin_surfaces"] += 1;
+    }
+  }
+  for (const auto& [key, border] : surfaces->borderSurfaces) {
+    if (auto it = result.find(top_level_name(key.first, world)); it != result.end()) {
+      it->second["border_surfaces"] += 1;
+    }
+  }
+  return result;
+}
+
+// threshold file: <detector|*> <metric> <maximum>, '#' starts a comment
+bool read_thresholds(const std::string& file,
+                     std::map<std::pair<std::string, std::string>, long>& thresholds) {
+  std::ifstream in(file);
+  if (!in) {
+    printout(ERROR, "GeometryCensus", "unable to read thresholds from " + file);
+    return false;
+  }
+  std::string line;
+  while (std::getline(in, line)) {
+    line = line.substr(0, line.find('#'));
+    std::istringstream iss(line);
+    std::string det, metric;
+    long maximum;
+    if (iss >> det >> metric >> maximum) {
+      thresholds[{det, metric}] = maximum;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+static void usage_geometry_census(int argc, char** argv) {
+  std::cerr
+      << "Usage: -plugin <name> -arg [-arg]                                                  \n"
+         "     output:<string>          write census as csv                                  \n"
+         "     thresholds:<string>      fail if census exceeds thresholds in file            \n"
+         "     baseline:<string>        write thresholds file from this census               \n"
+         "     tolerance:<double>       headroom factor for baseline (default 1.05)          \n"
+         "\tArguments given: "
+      << arguments(argc, argv) << std::endl;
+  std::exit(EINVAL);
+}
+
+// Plugin to count geometry complexity per top-level detector
+static long geometry_census(Detector& desc, int argc, char** argv) {
+  std::string output, thresholds_file, baseline;
+  double tolerance = 1.05;
+  for (int i = 0; i < argc && argv[i]; ++i) {
+    if (0 == std::strncmp("output:", argv[i], 7))
+      output = (argv[i] + 7);
+    else if (0 == std::strncmp("thresholds:", argv[i], 11))
+      thresholds_file = (argv[i] + 11);
+    else if (0 == std::strncmp("baseline:", argv[i], 9))
+      baseline = (argv[i] + 9);
+    else if (0 == std::strncmp("tolerance:", argv[i], 10))
+      tolerance = std::atof(argv[i] + 10);
+    else {
+      std::cerr << "Unexpected argument \"" << argv[i] << "\"" << std::endl;
+      usage_geometry_census(argc, argv);
+    }
+  }
+
+  const auto census = take_census(desc);
+
+  std::string header = fmt::format("{:<32}", "detector");
+  for (const auto& metric : kMetrics) {
+    header += fmt::format(" {:>15}", metric);
+  }
+  printout(INFO, "GeometryCensus", header);
+  for (const auto& [det, counts] : census) {
+    std::string line = fmt::format("{:<32}", det);
+    for (const auto& metric : kMetrics) {
+      line += fmt::format(" {:>15}", counts.at(metric));
+    }
+    printout(INFO, "GeometryCensus", line);
+  }
+
+  if (!output.empty()) {
+    std::ofstream out(output);
+    out << "detector";
+    for (const auto& metric : kMetrics) {
+      out << "," << metric;
+    }
+    out << "\n";
+    for (const auto& [det, counts] : census) {
+      out << det;
+      for (const auto& metric : kMetrics) {
+        out << "," << counts.at(metric);
+      }
+      out << "\n";
+    }
+  }
+
+  if (!baseline.empty()) {
+    std::ofstream out(baseline);
+    out << fmt::format("# geometry census thresholds, tolerance {}\n", tolerance);
+    for (const auto& [det, counts] : census) {
+      for (const auto& metric : kMetrics) {
+        out << fmt::format("{} {} {}\n", det, metric,
+                           static_cast<long>(std::ceil(tolerance * counts.at(metric))));
+      }
+    }
+  }
+
+  if (!thresholds_file.empty()) {
+    std::map<std::pair<std::string, std::string>, long> thresholds;
+    if (!read_thresholds(thresholds_file, thresholds)) {
+      return 0;
+    }
+    bool failed = false;
+    for (const auto& [key, maximum] : thresholds) {
+      const auto& [det, metric] = key;
+      for (const auto& [name, counts] : census) {
+        if (det != "*" && det != name) {
+          continue;
+        }
+        auto it = counts.find(metric);
+        if (it == counts.end()) {
+          printout(WARNING, "GeometryCensus", "unknown metric " + metric);
+          continue;
+        }
+        if (it->second > maximum) {
+          printout(ERROR, "GeometryCensus",
+                   fmt::format("{} {} = {} exceeds threshold {}", name, metric, it->second,
+                               maximum));
+          failed = true;
+        }
+      }
+    }
+    if (failed) {
+      return 0;
+    }
+    printout(INFO, "GeometryCensus", "all thresholds satisfied");
+  }
+  return 1;
+}
+
+DECLARE_APPLY(epic_GeometryCensus, geometry_census)
@@ -152,7 +152,7 @@ std::vector<Point> fillHexagons(Point ref, double lside, double rmin, double rma
   return res;
 }
 
-bool isPointInsidePolygon(Point p, std::vector<Point> vertices) {
+bool isPointInsidePolygon(Point p, const std::vector<Point>& vertices) {
   int n      = vertices.size();
   bool check = false; // check == false (outside the polygon), check == true (inside the polygon)
   const double tolerance = 0.000001;
@@ -198,20 +198,84 @@ bool isPointInsidePolygon(Point p, std::vector<Point> vertices) {
   return check;
 }
 
-bool isBoxTotalInsidePolygon(Point box[4], std::vector<Point> vertices) {
+bool isBoxTotalInsidePolygon(Point box[4], const std::vector<Point>& vertices) {
   bool pt_check = true;
   for (int i = 0; i < 4; i++)
     pt_check = pt_check && isPointInsidePolygon(box[i], vertices);
   return pt_check;
 }
 
-bool isBoxPartialInsidePolygon(Point box[4], std::vector<Point> vertices) {
+bool isBoxPartialInsidePolygon(Point box[4], const std::vector<Point>& vertices) {
   bool pt_check = false;
   for (int i = 0; i < 4; i++)
     pt_check = pt_check || isPointInsidePolygon(box[i], vertices);
   return pt_check;
 }
 
+// isPointInsidePolygon for the points (xs[k], ys[k]), with the four checks evaluated for all the
+// points: each check flips its own flag, and a point is inside if any of the flags is set
+static void arePointsInsidePolygon(const std::vector<double>& xs, const std::vector<double>& ys,
+                                   const std::vector<Point>& vertices,
+                                   std::vector<unsigned char>& inside) {
+  const size_t np        = xs.size();
+  const int n            = vertices.size();
+  const double tolerance = 0.000001;
+
+  std::vector<unsigned char> on_vertex(np, 0), on_vertical(np, 0), on_horizontal(np, 0),
+      crossing(np, 0);
+  for (int i = 0, j = n - 1; i < n; j = i++) {
+    const double xi = vertices[i].x(), yi = vertices[i].y();
+    const double xj = vertices[j].x(), yj = vertices[j].y();
+    for (size_t k = 0; k < np; ++k) {
+      const double px       = xs[k];
+      const double py       = ys[k];
+      const bool near_xi    = std::abs(px - xi) < tolerance;
+      const bool near_yi    = std::abs(py - yi) < tolerance;
+      const bool spans_y    = (yi > py) != (yj > py);
+      const double criteria = (xj - xi) * (py - yi) / (yj - yi) + xi;
+      on_vertex[k] ^= near_xi & near_yi;
+      on_vertical[k] ^= near_xi & (std::abs(px - xj) < tolerance) & spans_y;
+      on_horizontal[k] ^= near_yi & (std::abs(py - yj) < tolerance) & ((xi > px) != (xj > px));
+      crossing[k] ^= spans_y & ((px < criteria) | (std::abs(px - criteria) < tolerance));
+    }
+  }
+  inside.resize(np);
+  for (size_t k = 0; k < np; ++k) {
+    inside[k] = on_vertex[k] | on_vertical[k] | on_horizontal[k] | crossing[k];
+  }
+}
+
+std::vector<unsigned int>
+boxesTotalInsidePolygons(const std::vector<Point>& centers, double hx, double hy,
+                         const std::vector<std::vector<Point>>& polygons) {
+  // the four corners of all boxes, corner c of box b at index 4 * b + c
+  const size_t nb = centers.size();
+  std::vector<double> xs(4 * nb), ys(4 * nb);
+  for (size_t b = 0; b < nb; ++b) {
+    const double x = centers[b].x(), y = centers[b].y();
+    xs[4 * b]      = x + hx;
+    ys[4 * b]      = y + hy;
+    xs[4 * b + 1]  = x - hx;
+    ys[4 * b + 1]  = y + hy;
+    xs[4 * b + 2]  = x - hx;
+    ys[4 * b + 2]  = y - hy;
+    xs[4 * b + 3]  = x + hx;
+    ys[4 * b + 3]  = y - hy;
+  }
+
+  std::vector<unsigned int> masks(nb, 0);
+  std::vector<unsigned char> inside;
+  for (size_t k = 0; k < polygons.size() && k < 32; ++k) {
+    arePointsInsidePolygon(xs, ys, polygons[k], inside);
+    for (size_t b = 0; b < nb; ++b) {
+      if (inside[4 * b] && inside[4 * b + 1] && inside[4 * b + 2] && inside[4 * b + 3]) {
+        masks[b] |= 1u << k;
+      }
+    }
+  }
+  return masks;
+}
+
 std::vector<std::pair<double, double>>
 getPolygonVertices(std::pair<double, double> center, double radius, double angle_0, int numSides) {
   std::vector<std::pair<double, double>> vertices;
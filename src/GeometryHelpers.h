@@ -31,11 +31,26 @@ inline std::vector<Point> fillSquares(Point ref, double size, double rmin, doubl
 std::vector<Point> fillHexagons(Point ref, double lside, double rmin, double rmax,
                                 double phmin = -M_PI, double phmax = M_PI);
 
-bool isPointInsidePolygon(Point p, std::vector<Point> vertices);
+bool isPointInsidePolygon(Point p, const std::vector<Point>& vertices);
 
-bool isBoxTotalInsidePolygon(Point box[4], std::vector<Point> vertices);
+bool isBoxTotalInsidePolygon(Point box[4], const std::vector<Point>& vertices);
 
-bool isBoxPartialInsidePolygon(Point box[4], std::vector<Point> vertices);
+bool isBoxPartialInsidePolygon(Point box[4], const std::vector<Point>& vertices);
+
+/** Classify boxes against several polygons in one pass.
+   *
+   * Same result as isBoxTotalInsidePolygon for every box and polygon, with the loop over the
+   * box corners innermost so that the compiler can vectorize it.
+   *
+   * @param centers   box centers
+   * @param hx        half box size in x
+   * @param hy        half box size in y
+   * @param polygons  up to 32 polygons
+   * @return per box, bit k set if the box is totally inside polygons[k]
+   */
+std::vector<unsigned int>
+boxesTotalInsidePolygons(const std::vector<Point>& centers, double hx, double hy,
+                         const std::vector<std::vector<Point>>& polygons);
 
 std::vector<std::pair<double, double>>
 getPolygonVertices(std::pair<double, double> center, double radius, double angle_0, int numSides);
@@ -0,0 +1,339 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 ePIC Collaboration
+
+//==========================================================================
+//  Persistent geometry snapshot
+//
+//  Loads a detector description from a ROOT snapshot keyed by a hash of the
+//  rendered compact tree (all included xml files), and of the plugin library
+//  that builds it. When no matching snapshot exists the detector is built
+//  from the compact file as usual and a new snapshot is written.
+//
+//  The hash also covers the detector selection environment (REQUIRED_ and
+//  IGNORED_DETECTORS(_TYPES)), the environment variables referenced by the
+//  compact files, and environment variables named like compact constants.
+//
+//  Snapshots contain the geometry, DetElement tree, readouts and constants.
+//  DetElement extensions are only persistent for the DDRec data types with
+//  a ROOT dictionary (parameters, surfaces, layering data), so no snapshot
+//  is written when any DetElement carries another extension (e.g. the dRICH
+//  sensor table); such configurations are always built from the compact file.
+//  Fields are not persistent; the <fields> of the compact tree are loaded
+//  again after a snapshot is loaded.
+//--------------------------------------------------------------------------
+
+#include <DD4hep/DetFactoryHelper.h>
+#include <DD4hep/Factories.h>
+#include <DD4hep/Primitives.h>
+#include <DD4hep/Printout.h>
+#include <DD4hep/detail/DetectorInterna.h>
+#include <DDRec/DetectorData.h>
+#include <DDRec/Surface.h>
+#include <XML/DocumentHandler.h>
+
+#include <RVersion.h>
+#include <TClass.h>
+#include <TFile.h>
+
+#include <fmt/core.h>
+
+#include <dlfcn.h>
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+using namespace dd4hep;
+
+namespace {
+
+const char kSnapshotAnchor = 0;
+
+// replace $VAR and ${VAR} by the value of the environment variable
+std::string expand_env(const std::string& str) {
+  static const std::regex env_re(R"(\$\{?([A-Za-z_][A-Za-z0-9_]*)\}?)");
+  std::string result;
+  auto last = str.cbegin();
+  for (std::sregex_iterator it(str.cbegin(), str.cend(), env_re), end; it != end; ++it) {
+    result.append(last, str.cbegin() + it->position());
+    const char* value = std::getenv((*it)[1].str().c_str());
+    result += (value != nullptr ? value : "");
+    last = str.cbegin() + it->position() + it->length();
+  }
+  result.append(last, str.cend());
+  return result;
+}
+
+struct CompactTree {
+  std::string content;                  // concatenated content of all files
+  std::vector<std::string> field_files; // included files that define fields
+  std::set<std::string> env_names;      // environment variables that may change the geometry
+};
+
+// environment variables of the detector selection, see DetectorSelection.h
+const std::array<const char*, 4> kSelectionEnv{"REQUIRED_DETECTORS", "REQUIRED_DETECTOR_TYPES",
+                                               "IGNORED_DETECTORS", "IGNORED_DETECTOR_TYPES"};
+
+// recursively collect the compact file and everything it includes by reference
+void collect_compact_tree(const fs::path& file, CompactTree& tree, std::set<fs::path>& visited) {
+  const fs::path canonical = fs::weakly_canonical(file);
+  if (!visited.insert(canonical).second) {
+    return;
+  }
+  std::ifstream in(canonical);
+  if (!in) {
+    // missing references are resolved (or reported) by the full build
+    tree.content += "missing:" + canonical.string() + "\n";
+    return;
+  }
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  const std::string text = buffer.str();
+  tree.content += canonical.string() + "\n" + text;
+  if (text.find("<fields>") != std::string::npos) {
+    tree.field_files.push_back(canonical.string());
+  }
+  // variables referenced as $VAR or ${VAR}, and constants that the environment may override
+  static const std::regex env_re(R"(\$\{?([A-Za-z_][A-Za-z0-9_]*))");
+  for (std::sregex_iterator it(text.cbegin(), text.cend(), env_re), end; it != end; ++it) {
+    tree.env_names.insert((*it)[1].str());
+  }
+  static const std::regex const_re(R"(<constant\s+name\s*=\s*"([^"]+)\")");
+  for (std::sregex_iterator it(text.cbegin(), text.cend(), const_re), end; it != end; ++it) {
+    tree.env_names.insert((*it)[1].str());
+  }
+
+  static const std::regex ref_re(R"((<include|<gdmlFile|<file)\s+ref\s*=\s*"([^"]+)\")");
+  for (std::sregex_iterator it(text.cbegin(), text.cend(), ref_re), end; it != end; ++it) {
+    fs::path ref(expand_env((*it)[2].str()));
+    if (ref.is_relative()) {
+      ref = canonical.parent_path() / ref;
+    }
+    collect_compact_tree(ref, tree, visited);
+  }
+}
+
+// identify the plugin library by path, size and modification time, and the ROOT release
+std::string library_identity() {
+  Dl_info info;
+  if (dladdr(&kSnapshotAnchor, &info) == 0 || info.dli_fname == nullptr) {
+    return ROOT_RELEASE;
+  }
+  std::error_code ec;
+  const fs::path lib(info.dli_fname);
+  const auto size  = fs::file_size(lib, ec);
+  const auto mtime = fs::last_write_time(lib, ec).time_since_epoch().count();
+  return fmt::format("{}:{}:{}:{}", lib.string(), size, mtime, ROOT_RELEASE);
+}
+
+// values of the environment variables that may change the geometry, unset ones are skipped
+std::string environment_identity(const CompactTree& tree) {
+  std::set<std::string> names(tree.env_names);
+  names.insert(kSelectionEnv.begin(), kSelectionEnv.end());
+  std::string identity;
+  for (const auto& name : names) {
+    if (const char* value = std::getenv(name.c_str())) {
+      identity += name + "=" + value + "\n";
+    }
+  }
+  return identity;
+}
+
+// extension types that may be written to a snapshot, keyed like DetElement extensions by the
+// hash of the extension type; the entries only wrap the object, so the object type must have a
+// ROOT dictionary. Any other extension (e.g. the dRICH sensor table) prevents the snapshot.
+template <typename T> void allow_extension(std::map<unsigned long long, std::string>& allowed) {
+  TClass* cl = TClass::GetClass(typeid(T), kTRUE, kTRUE);
+  if (cl != nullptr && cl->HasDictionary()) {
+    allowed.emplace(detail::typeHash64<T>(), cl->GetName());
+  }
+}
+
+const std::map<unsigned long long, std::string>& streamable_extensions() {
+  static const std::map<unsigned long long, std::string> allowed = []() {
+    std::map<unsigned long long, std::string> types;
+    allow_extension<rec::VariantParameters>(types);
+    allow_extension<rec::VolSurfaceList>(types);
+    allow_extension<rec::LayeredCalorimeterData>(types);
+    allow_extension<rec::ZPlanarData>(types);
+    allow_extension<rec::ZDiskPetalsData>(types);
+    allow_extension<rec::ConicalSupportData>(types);
+    allow_extension<rec::NeighbourSurfacesData>(types);
+    return types;
+  }();
+  return allowed;
+}
+
+// paths of the DetElements below det with extensions that cannot be written to a snapshot
+void unstreamable_extensions(DetElement det, std::vector<std::string>& result) {
+  const auto& allowed = streamable_extensions();
+  for (const auto& [key, entry] : det.ptr()->extensions) {
+    if (allowed.count(key) == 0) {
+      result.push_back(fmt::format("{} (extension {:016x})", det.path(), key));
+      break;
+    }
+  }
+  for (const auto& [name, child] : det.children()) {
+    unstreamable_extensions(child, result);
+  }
+}
+
+// copy the non-empty <fields> of the compact tree into one compact file, so that loading it
+// after a snapshot adds the fields without adding the constants or detectors again
+bool write_fields_file(const std::vector<std::string>& field_files, const std::string& path) {
+  xml::DocumentHandler handler;
+  xml::DocumentHolder fields_doc(handler.create("lccdd", "fields of the compact tree"));
+  xml::Element fields_root = fields_doc.root();
+  long n_fields            = 0;
+  for (const auto& file : field_files) {
+    xml::DocumentHolder doc(handler.load(file));
+    for (xml_coll_t f(doc.root(), _U(fields)); f; ++f) {
+      if (xml_coll_t(f, _U(field)).size() > 0) {
+        fields_root.append(fields_doc.clone(f));
+        ++n_fields;
+      }
+    }
+  }
+  return n_fields > 0 && handler.output(fields_doc, path) == 1;
+}
+
+bool snapshot_readable(const std::string& path) {
+  if (!fs::exists(path)) {
+    return false;
+  }
+  std::unique_ptr<TFile> file(TFile::Open(path.c_str(), "READ"));
+  return file != nullptr && !file->IsZombie() && file->FindKey("Geometry") != nullptr;
+}
+
+long apply_plugin(Detector& desc, const char* plugin, std::vector<std::string> args) {
+  std::vector<char*> argv;
+  for (auto& arg : args) {
+    argv.push_back(arg.data());
+  }
+  argv.push_back(nullptr);
+  return desc.apply(plugin, static_cast<int>(args.size()), argv.data());
+}
+
+} // namespace
+
+static void usage_geometry_snapshot(int argc, char** argv) {
+  std::cerr
+      << "Usage: -plugin <name> -arg [-arg]                                                  \n"
+         "     compact:<string>         rendered compact file, e.g. epic_craterlake.xml      \n"
+         "     cache:<string>           snapshot directory (default $DETECTOR_PATH/snapshots)\n"
+         "     readonly                 never write a new snapshot                           \n"
+         "\tArguments given: "
+      << arguments(argc, argv) << std::endl;
+  std::exit(EINVAL);
+}
+
+// Plugin to load the detector from a snapshot, or build it and write one
+static long geometry_snapshot(Detector& desc, int argc, char** argv) {
+  std::string compact, cache = "$DETECTOR_PATH/snapshots";
+  bool readonly = false;
+  for (int i = 0; i < argc && argv[i]; ++i) {
+    if (0 == std::strncmp("compact:", argv[i], 8))
+      compact = (argv[i] + 8);
+    else if (0 == std::strncmp("cache:", argv[i], 6))
+      cache = (argv[i] + 6);
+    else if (0 == std::strcmp("readonly", argv[i]))
+      readonly = true;
+    else {
+      std::cerr << "Unexpected argument \"" << argv[i] << "\"" << std::endl;
+      usage_geometry_snapshot(argc, argv);
+    }
+  }
+  if (compact.empty()) {
+    usage_geometry_snapshot(argc, argv);
+  }
+  cache = expand_env(cache);
+
+  const auto start = std::chrono::steady_clock::now();
+  auto elapsed_ms  = [&start]() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+  };
+
+  CompactTree tree;
+  std::set<fs::path> visited;
+  collect_compact_tree(compact, tree, visited);
+  tree.content += library_identity();
+  tree.content += environment_identity(tree);
+  const std::string hash = fmt::format("{:016x}", detail::hash64(tree.content));
+  const std::string snapshot =
+      (fs::path(cache) / fmt::format("{}_{}.root", fs::path(compact).stem().string(), hash))
+          .string();
+  printout(INFO, "GeometrySnapshot", "%s: %zu files, hash %s", compact.c_str(), visited.size(),
+           hash.c_str());
+
+  if (snapshot_readable(snapshot)) {
+    apply_plugin(desc, "DD4hep_RootLoader", {"-input", snapshot});
+    const std::string fields_file =
+        (fs::temp_directory_path() / fmt::format("epic_snapshot_fields.{}.xml", ::getpid()))
+            .string();
+    if (write_fields_file(tree.field_files, fields_file)) {
+      desc.fromXML(fields_file);
+    }
+    std::error_code ec;
+    fs::remove(fields_file, ec);
+    printout(INFO, "GeometrySnapshot", "loaded snapshot %s in %.1f ms", snapshot.c_str(),
+             elapsed_ms());
+    return 1;
+  }
+
+  printout(INFO, "GeometrySnapshot", "no snapshot %s, building from compact", snapshot.c_str());
+  desc.fromCompact(compact);
+  printout(INFO, "GeometrySnapshot", "built %s in %.1f ms", compact.c_str(), elapsed_ms());
+
+  std::vector<std::string> unstreamable;
+  unstreamable_extensions(desc.world(), unstreamable);
+  if (!readonly && !unstreamable.empty()) {
+    printout(WARNING, "GeometrySnapshot",
+             "not writing snapshot, %zu DetElements have extensions that are not persistent, "
+             "e.g. %s",
+             unstreamable.size(), unstreamable.front().c_str());
+  } else if (!readonly) {
+    std::error_code ec;
+    fs::create_directories(cache, ec);
+    // write to a unique file first so concurrent jobs never see a partial snapshot
+    const std::string tmp = fmt::format("{}.{}.tmp", snapshot, ::getpid());
+    long written          = 0;
+    try {
+      written = apply_plugin(desc, "DD4hep_Geometry2ROOT", {"-output", tmp});
+    } catch (const std::exception& e) {
+      printout(WARNING, "GeometrySnapshot", "DD4hep_Geometry2ROOT failed: %s", e.what());
+    }
+    if (written <= 0 || !snapshot_readable(tmp)) {
+      printout(WARNING, "GeometrySnapshot", "unable to write snapshot %s", tmp.c_str());
+      fs::remove(tmp, ec);
+      return 1;
+    }
+    fs::rename(tmp, snapshot, ec);
+    if (ec) {
+      printout(WARNING, "GeometrySnapshot", "unable to write snapshot %s: %s", snapshot.c_str(),
+               ec.message().c_str());
+      fs::remove(tmp, ec);
+    } else {
+      printout(INFO, "GeometrySnapshot", "wrote snapshot %s", snapshot.c_str());
+    }
+  }
+  return 1;
+}
+
+DECLARE_APPLY(epic_GeometrySnapshot, geometry_snapshot)
@@ -27,6 +27,7 @@
 #include <math.h>
 #include <tuple>
 #include <vector>
+#include "ConstructionProfiler.h"
 
 using namespace dd4hep;
 
@@ -331,21 +332,28 @@ static std::tuple<int, std::pair<int, int>> add_12surface_disk(Detector& desc, A
     in_vertices.push_back(inpt);
   }
 
+  // classify all candidates against the outer boundary (bit 0) and the beampipe cutout (bit 1)
+  // in one pass, and keep the extent of the ones inside the outer boundary
+  auto inside = epic::geo::boxesTotalInsidePolygons(points, half_modx, half_mody,
+                                                    {out_vertices, in_vertices});
+  std::vector<epic::geo::Point> placed;
+  placed.reserve(points.size());
   double minX = 0., maxX = 0., minY = 0., maxY = 0.;
-  for (auto& square : points) {
-    epic::geo::Point box[4] = {{square.x() + half_modx, square.y() + half_mody},
-                               {square.x() - half_modx, square.y() + half_mody},
-                               {square.x() - half_modx, square.y() - half_mody},
-                               {square.x() + half_modx, square.y() - half_mody}};
-    if (epic::geo::isBoxTotalInsidePolygon(box, out_vertices)) {
-      if (square.x() < minX)
-        minX = square.x();
-      if (square.y() < minY)
-        minY = square.x();
-      if (square.x() > maxX)
-        maxX = square.x();
-      if (square.y() > maxY)
-        maxY = square.x();
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (!(inside[i] & 1u)) {
+      continue;
+    }
+    auto& square = points[i];
+    if (square.x() < minX)
+      minX = square.x();
+    if (square.y() < minY)
+      minY = square.x();
+    if (square.x() > maxX)
+      maxX = square.x();
+    if (square.y() > maxY)
+      maxY = square.x();
+    if (!(inside[i] & 2u)) {
+      placed.push_back(square);
     }
   }
 
@@ -355,25 +363,15 @@ static std::tuple<int, std::pair<int, int>> add_12surface_disk(Detector& desc, A
   int N_column   = std::round((maxX - minX) / modSize.x());
   auto rowcolumn = std::make_pair(N_row, N_column);
 
-  for (auto& square : points) {
-    epic::geo::Point box[4] = {{square.x() + half_modx, square.y() + half_mody},
-                               {square.x() - half_modx, square.y() + half_mody},
-                               {square.x() - half_modx, square.y() - half_mody},
-                               {square.x() + half_modx, square.y() - half_mody}};
-    if (epic::geo::isBoxTotalInsidePolygon(box, out_vertices)) {
-      if (!epic::geo::isBoxTotalInsidePolygon(box, in_vertices)) {
-        column = std::round((square.x() - minX) / modSize.x());
-        row    = std::round((maxY - square.y()) / modSize.y());
-        Transform3D tr_local =
-            RotationZYX(Nrot, 0.0, 0.0) * Translation3D(square.x(), square.y(), 0.0);
-        auto modPV = (has_envelope ? env_vol.placeVolume(modVol, tr_local)
-                                   : env.placeVolume(modVol, tr_global * tr_local));
-        modPV.addPhysVolID("sector", sector_id)
-            .addPhysVolID("row", row)
-            .addPhysVolID("column", column);
-        total_count++;
-      }
-    }
+  for (auto& square : placed) {
+    column = std::round((square.x() - minX) / modSize.x());
+    row    = std::round((maxY - square.y()) / modSize.y());
+
+    Transform3D tr_local = RotationZYX(Nrot, 0.0, 0.0) * Translation3D(square.x(), square.y(), 0.0);
+    auto modPV           = (has_envelope ? env_vol.placeVolume(modVol, tr_local)
+                                         : env.placeVolume(modVol, tr_global * tr_local));
+    modPV.addPhysVolID("sector", sector_id).addPhysVolID("row", row).addPhysVolID("column", column);
+    total_count++;
   }
 
   printout(DEBUG, "HomogeneousCalorimeter_geo", "Number of modules: %d", total_count);
@@ -386,4 +384,4 @@ static std::tuple<int, std::pair<int, int>> add_12surface_disk(Detector& desc, A
 }
 
 //@}
-DECLARE_DETELEMENT(epic_HomogeneousCalorimeter, create_detector)
+DECLARE_PROFILED_DETELEMENT(epic_HomogeneousCalorimeter, create_detector)
@@ -15,6 +15,7 @@
 #include <XML/Helper.h>
 #include "XML/Utilities.h"
 #include "DD4hepDetectorHelper.h"
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -280,4 +281,4 @@ static Ref_t create_detector(Detector& det, xml_h e, SensitiveDetector /* sens *
   return sdet;
 }
 
-DECLARE_DETELEMENT(IP6BeamPipe, create_detector)
+DECLARE_PROFILED_DETELEMENT(IP6BeamPipe, create_detector)
@@ -8,10 +8,13 @@
 //==========================================================================
 
 #include "DD4hep/DetFactoryHelper.h"
+#include "DD4hep/Printout.h"
 #include <XML/Helper.h>
 #include <XML/Layering.h>
 #include <tuple>
 #include <vector>
+#include "ConstructionProfiler.h"
+#include "LayeredCalorimeterBuilder.h"
 
 using namespace dd4hep;
 
@@ -29,6 +32,10 @@ static Ref_t createDetector(Detector& desc, xml_h handle, SensitiveDetector sens
 
   Material air = desc.material("Air");
 
+  // full: one volume per slice; homogenized: the slices of each layer are built as one volume of
+  // their mixture, with the slice ID of the sensitive slice
+  bool homogenized = epic::calorimeter::homogenizedMode(detElem, "InsertCalorimeter");
+
   // Getting beampipe hole dimensions
   const xml::Component& beampipe_hole_xml = detElem.child(_Unicode(beampipe_hole));
   const double hole_radius_initial        = dd4hep::getAttrOrDefault<double>(
@@ -99,7 +106,6 @@ static Ref_t createDetector(Detector& desc, xml_h handle, SensitiveDetector sens
   Assembly assembly(detName);
   // FIXME Workaround for https://github.com/eic/epic/issues/411
   assembly.setVisAttributes(desc.visAttributes("InvisibleWithDaughters"));
-  PlacedVolume pv;
 
   // Keeps track of the z location as we move longiduinally through the insert
   // Will use this tracking variable as input to get_hole_rxy
@@ -107,11 +113,16 @@ static Ref_t createDetector(Detector& desc, xml_h handle, SensitiveDetector sens
 
   int layer_num = 1;
 
+  // The hole follows the beampipe and changes from layer to layer, so every layer is built; the
+  // material budget is summarized per section
+  epic::calorimeter::BudgetSummary budgets;
+
   // Looping through all the different layer sections (W/Sc, Steel/Sc, backplate)
   for (xml_coll_t c(detElem, _U(layer)); c; c++) {
     xml_comp_t x_layer     = c;
     int repeat             = x_layer.repeat();
     double layer_thickness = x_layer.thickness();
+    epic::calorimeter::LayerBudget section_budget;
 
     // Looping through the number of repeated layers in each section
     for (int i = 0; i < repeat; i++) {
@@ -127,45 +138,33 @@ static Ref_t createDetector(Detector& desc, xml_h handle, SensitiveDetector sens
       // Removing beampipe shape from each layer
       Tube layer_hole(0., hole_r, layer_thickness / 2.);
       SubtractionSolid layer_with_hole(layer, layer_hole, Position(hole_x, hole_y, 0.));
-      Volume layer_vol(layer_name, layer_with_hole, air);
-
-      int slice_num  = 1;
-      double slice_z = -layer_thickness / 2.; // Keeps track of slices' z locations in each layer
+      epic::calorimeter::LayerType layer_type;
+      layer_type.volume = Volume(layer_name, layer_with_hole, air);
 
-      // Looping over each layer's slices
-      for (xml_coll_t l(x_layer, _U(slice)); l; l++) {
-        xml_comp_t x_slice     = l;
-        double slice_thickness = x_slice.thickness();
-        std::string slice_name = layer_name + _toString(slice_num, "slice%d");
-        Material slice_mat     = desc.material(x_slice.materialStr());
-        slice_z += slice_thickness / 2.; // Going to slice halfway point
-
-        // Each slice within a layer has the same hole radius and x-y position
+      // Each slice within a layer has the same hole radius and x-y position
+      auto slice_shape = [&](double slice_thickness) -> Solid {
         Box slice(width / 2., height / 2., slice_thickness / 2.);
         Tube slice_hole(0., hole_r, slice_thickness / 2.);
-        SubtractionSolid slice_with_hole(slice, slice_hole, Position(hole_x, hole_y, 0.));
-        Volume slice_vol(slice_name, slice_with_hole, slice_mat);
-
-        // Setting appropriate slices as sensitive
-        if (x_slice.isSensitive()) {
-          sens.setType("calorimeter");
-          slice_vol.setSensitiveDetector(sens);
-        }
-
-        // Setting slice attributes
-        slice_vol.setAttributes(desc, x_slice.regionStr(), x_slice.limitsStr(), x_slice.visStr());
-
-        // Placing slice within layer
-        pv = layer_vol.placeVolume(slice_vol,
-                                   Transform3D(RotationZYX(0, 0, 0), Position(0., 0., slice_z)));
-        pv.addPhysVolID("slice", slice_num);
-        slice_z += slice_thickness / 2.;
-        z_distance_traversed += slice_thickness;
-        slice_num++;
+        return SubtractionSolid(slice, slice_hole, Position(hole_x, hole_y, 0.));
+      };
+      if (homogenized) {
+        epic::calorimeter::buildHomogenizedSlices(desc, layer_type, x_layer, layer_thickness, sens,
+                                                  layer_name, slice_shape);
+      } else {
+        epic::calorimeter::buildSlices(desc, layer_type, x_layer, layer_thickness, sens,
+                                       layer_name, slice_shape);
       }
+      z_distance_traversed += layer_type.budget.thickness;
 
       // Setting layer attributes
-      layer_vol.setAttributes(desc, x_layer.regionStr(), x_layer.limitsStr(), x_layer.visStr());
+      layer_type.volume.setAttributes(desc, x_layer.regionStr(), x_layer.limitsStr(),
+                                      x_layer.visStr());
+      if (i == 0) {
+        section_budget      = layer_type.budget;
+        section_budget.name = layer_name;
+      }
+      section_budget.repeat++;
+
       /*
         Placing each layer inside assembly
         -length/2. is front of detector in global coordinate system
@@ -176,15 +175,15 @@ static Ref_t createDetector(Detector& desc, xml_h handle, SensitiveDetector sens
                  Adding layer_thickness / 2. goes to half the first layer thickness (proper place to put layer)
                  Each loop over repeat will increases z_distance_traversed by layer_thickness
       */
-      pv = assembly.placeVolume(
-          layer_vol, Transform3D(RotationZYX(0, 0, 0),
-                                 Position(0., 0.,
-                                          -length / 2. + (z_distance_traversed - layer_thickness) +
-                                              layer_thickness / 2.)));
-
-      pv.addPhysVolID("layer", layer_num);
+      epic::calorimeter::placeLayers(assembly, layer_type, 1,
+                                     -length / 2. + (z_distance_traversed - layer_thickness) +
+                                         layer_thickness / 2.,
+                                     0., layer_num);
       layer_num++;
     }
+    if (repeat > 0) {
+      budgets.add(section_budget);
+    }
   }
 
   DetElement det(detName, detID);
@@ -195,7 +194,11 @@ static Ref_t createDetector(Detector& desc, xml_h handle, SensitiveDetector sens
   PlacedVolume phv = motherVol.placeVolume(assembly, tr);
   phv.addPhysVolID("system", detID);
   det.setPlacement(phv);
+  budgets.report(det, "InsertCalorimeter");
+  if (homogenized) {
+    budgets.addMassFractions(desc, "InsertCalorimeter");
+  }
 
   return det;
 }
-DECLARE_DETELEMENT(epic_InsertCalorimeter, createDetector)
+DECLARE_PROFILED_DETELEMENT(epic_InsertCalorimeter, createDetector)
@@ -15,6 +15,13 @@
 #include <XML/Helper.h>
 #include "XML/Layering.h"
 #include "XML/Utilities.h"
+#include "ConstructionProfiler.h"
+#include "SliceMixture.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <tuple>
+#include <vector>
 using namespace dd4hep;
 
 struct moduleParamsStrct {
@@ -115,6 +122,26 @@ struct sliceParamsStrct {
   std::string slice_limStr = "";
 };
 
+struct modulePosStrct {
+  double x, y, z;
+};
+
+// volumes of a scintillator plate, shared between layers with identical slices
+struct scintPlateStrct {
+  Volume foilgrid;
+  Volume foil_tb;
+  Volume foil_lr;
+  Volume tower;
+};
+
+// slices with the same key only differ in their readout IDs, which are set on the placements
+using sliceKey = std::tuple<int, double, std::string, std::string, std::string, std::string>;
+
+sliceKey getSliceKey(const sliceParamsStrct& sl_param) {
+  return {sl_param.slice_partID, sl_param.slice_thick,  sl_param.slice_matStr,
+          sl_param.slice_visStr, sl_param.slice_regStr, sl_param.slice_limStr};
+}
+
 //************************************************************************************************************
 //************************** Assembly for absorber plates  ***************************************************
 //************************************************************************************************************
@@ -208,6 +235,7 @@ Volume createScintillatorTower(Detector& desc, std::string basename, double w_to
 //************************** create scintillator plate with separations for 8M *******************************
 //************************************************************************************************************
 Assembly createScintillatorPlateEightM(Detector& desc, std::string basename,
+                                       std::string platename, scintPlateStrct& plate,
                                        //                                         int modID,
                                        int layerID, double h_mod, double w_mod, double t_mod_tp,
                                        double t_mod_sp, double t_slice, double w_notch,
@@ -266,35 +294,28 @@ Assembly createScintillatorPlateEightM(Detector& desc, std::string basename,
   const std::vector<double> zStepYTi     = {0., 0.};
   const std::vector<double> zStepScaleTi = {1., 1.};
 
-  ExtrudedPolygon foilgrid =
-      ExtrudedPolygon(xCoordTi, yCoordTi, zStepTi, zStepXTi, zStepYTi, zStepScaleTi);
-  Box foil_t((w_plate + 2 * t_foil) / 2., t_foil / 2., t_slice / 2.);
-  Box foil_s(t_foil / 2., h_plate / 2., t_slice / 2.);
-  Volume foilgrid_vol(basename + "_ESRFoil_" + _toString(layerID, "_layer_%d"), foilgrid,
-                      slice_mat);
-  Volume foil_t_vol(basename + "_ESRFoilT_" + _toString(layerID, "_layer_%d"), foil_t, slice_mat);
-  Volume foil_b_vol(basename + "_ESRFoilB_" + _toString(layerID, "_layer_%d"), foil_t, slice_mat);
-  Volume foil_l_vol(basename + "_ESRFoilL_" + _toString(layerID, "_layer_%d"), foil_s, slice_mat);
-  Volume foil_r_vol(basename + "_ESRFoilR_" + _toString(layerID, "_layer_%d"), foil_s, slice_mat);
-  // Setting slice attributes
-  if (renderComp) {
-    foilgrid_vol.setAttributes(desc, region, limit, "LFHCALLayerSepVis");
-    foil_t_vol.setAttributes(desc, region, limit, "LFHCALLayerSepVis");
-    foil_b_vol.setAttributes(desc, region, limit, "LFHCALLayerSepVis");
-    foil_l_vol.setAttributes(desc, region, limit, "LFHCALLayerSepVis");
-    foil_r_vol.setAttributes(desc, region, limit, "LFHCALLayerSepVis");
-  } else {
-    foilgrid_vol.setAttributes(desc, region, limit, "InvisibleNoDaughters");
-    foil_t_vol.setAttributes(desc, region, limit, "InvisibleNoDaughters");
-    foil_b_vol.setAttributes(desc, region, limit, "InvisibleNoDaughters");
-    foil_l_vol.setAttributes(desc, region, limit, "InvisibleNoDaughters");
-    foil_r_vol.setAttributes(desc, region, limit, "InvisibleNoDaughters");
+  // foil and tower volumes are shared between all layers with identical slices
+  if (!plate.tower.isValid()) {
+    ExtrudedPolygon foilgrid =
+        ExtrudedPolygon(xCoordTi, yCoordTi, zStepTi, zStepXTi, zStepYTi, zStepScaleTi);
+    Box foil_t((w_plate + 2 * t_foil) / 2., t_foil / 2., t_slice / 2.);
+    Box foil_s(t_foil / 2., h_plate / 2., t_slice / 2.);
+    plate.foilgrid = Volume(platename + "_ESRFoil", foilgrid, slice_mat);
+    plate.foil_tb  = Volume(platename + "_ESRFoilTB", foil_t, slice_mat);
+    plate.foil_lr  = Volume(platename + "_ESRFoilLR", foil_s, slice_mat);
+    // Setting slice attributes
+    std::string foilVis = renderComp ? "LFHCALLayerSepVis" : "InvisibleNoDaughters";
+    plate.foilgrid.setAttributes(desc, region, limit, foilVis);
+    plate.foil_tb.setAttributes(desc, region, limit, foilVis);
+    plate.foil_lr.setAttributes(desc, region, limit, foilVis);
+    plate.tower = createScintillatorTower(desc, platename + "_tower", w_tow, h_tow, t_slice,
+                                          slice_mat, region, limit, vis, sens, renderComp);
   }
-  pvm = modScintAssembly.placeVolume(foilgrid_vol, Position(0, 0, 0));
-  pvm = modScintAssembly.placeVolume(foil_t_vol, Position(0, 1.5 * t_foil + h_tow, 0));
-  pvm = modScintAssembly.placeVolume(foil_b_vol, Position(0, -(1.5 * t_foil + h_tow), 0));
-  pvm = modScintAssembly.placeVolume(foil_l_vol, Position(-(3.5 * t_foil + 2 * w_tow), 0, 0));
-  pvm = modScintAssembly.placeVolume(foil_r_vol, Position((3.5 * t_foil + 2 * w_tow), 0, 0));
+  pvm = modScintAssembly.placeVolume(plate.foilgrid, Position(0, 0, 0));
+  pvm = modScintAssembly.placeVolume(plate.foil_tb, Position(0, 1.5 * t_foil + h_tow, 0));
+  pvm = modScintAssembly.placeVolume(plate.foil_tb, Position(0, -(1.5 * t_foil + h_tow), 0));
+  pvm = modScintAssembly.placeVolume(plate.foil_lr, Position(-(3.5 * t_foil + 2 * w_tow), 0, 0));
+  pvm = modScintAssembly.placeVolume(plate.foil_lr, Position((3.5 * t_foil + 2 * w_tow), 0, 0));
 
   // 8M module placement of scintillator for tower
   double rotZ[8] = {0, 0, 0, 0, 0, 0, 0, 0};
@@ -314,11 +335,8 @@ Assembly createScintillatorPlateEightM(Detector& desc, std::string basename,
   // loop over all towers within same module
   for (int i = 0; i < 8; i++) {
     // printout(DEBUG, "LFHCAL_geo", basename + _toString(i, "_tower_%d") + "\t" + _toString(modID) + "\t" + _toString(i) + "\t" + _toString(layerID));
-    Volume modScintTowerAss =
-        createScintillatorTower(desc, basename + _toString(i, "_tower_%d"), w_tow, h_tow, t_slice,
-                                slice_mat, region, limit, vis, sens, renderComp);
     pvm = modScintAssembly.placeVolume(
-        modScintTowerAss,
+        plate.tower,
         Transform3D(RotationZYX(rotZ[i], rotY[i], rotX[i]), Position(posX[i], posY[i], posZ[i])));
     towerx = i % 4;
     towery = 0;
@@ -337,6 +355,7 @@ Assembly createScintillatorPlateEightM(Detector& desc, std::string basename,
 //************************** create scintillator plate with separations for 4M *******************************
 //************************************************************************************************************
 Assembly createScintillatorPlateFourM(Detector& desc, std::string basename,
+                                      std::string platename, scintPlateStrct& plate,
                                       //                                         int modID,
                                       int layerID, double h_mod, double w_mod, double t_mod_tp,
                                       double t_mod_sp, double t_slice, double w_notch,
@@ -394,35 +413,28 @@ Assembly createScintillatorPlateFourM(Detector& desc, std::string basename,
   const std::vector<double> zStepYTi     = {0., 0.};
   const std::vector<double> zStepScaleTi = {1., 1.};
 
-  ExtrudedPolygon foilgrid =
-      ExtrudedPolygon(xCoordTi, yCoordTi, zStepTi, zStepXTi, zStepYTi, zStepScaleTi);
-  Box foil_t((w_plate + 2 * t_foil) / 2., t_foil / 2., t_slice / 2.);
-  Box foil_s(t_foil / 2., h_plate / 2., t_slice / 2.);
-  Volume foilgrid_vol(basename + "_ESRFoil_" + _toString(layerID, "_layer_%d"), foilgrid,
-                      slice_mat);
-  Volume foil_t_vol(basename + "_ESRFoilT_" + _toString(layerID, "_layer_%d"), foil_t, slice_mat);
-  Volume foil_b_vol(basename + "_ESRFoilB_" + _toString(layerID, "_layer_%d"), foil_t, slice_mat);
-  Volume foil_l_vol(basename + "_ESRFoilL_" + _toString(layerID, "_layer_%d"), foil_s, slice_mat);
-  Volume foil_r_vol(basename + "_ESRFoilR_" + _toString(layerID, "_layer_%d"), foil_s, slice_mat);
-  // Setting slice attributes
-  if (renderComp) {
-    foilgrid_vol.setAttributes(desc, region, limit, "LFHCALLayerSepVis");
-    foil_t_vol.setAttributes(desc, region, limit, "LFHCALLayerSepVis");
-    foil_b_vol.setAttributes(desc, region, limit, "LFHCALLayerSepVis");
-    foil_l_vol.setAttributes(desc, region, limit, "LFHCALLayerSepVis");
-    foil_r_vol.setAttributes(desc, region, limit, "LFHCALLayerSepVis");
-  } else {
-    foilgrid_vol.setAttributes(desc, region, limit, "InvisibleNoDaughters");
-    foil_t_vol.setAttributes(desc, region, limit, "InvisibleNoDaughters");
-    foil_b_vol.setAttributes(desc, region, limit, "InvisibleNoDaughters");
-    foil_l_vol.setAttributes(desc, region, limit, "InvisibleNoDaughters");
-    foil_r_vol.setAttributes(desc, region, limit, "InvisibleNoDaughters");
+  // foil and tower volumes are shared between all layers with identical slices
+  if (!plate.tower.isValid()) {
+    ExtrudedPolygon foilgrid =
+        ExtrudedPolygon(xCoordTi, yCoordTi, zStepTi, zStepXTi, zStepYTi, zStepScaleTi);
+    Box foil_t((w_plate + 2 * t_foil) / 2., t_foil / 2., t_slice / 2.);
+    Box foil_s(t_foil / 2., h_plate / 2., t_slice / 2.);
+    plate.foilgrid = Volume(platename + "_ESRFoil", foilgrid, slice_mat);
+    plate.foil_tb  = Volume(platename + "_ESRFoilTB", foil_t, slice_mat);
+    plate.foil_lr  = Volume(platename + "_ESRFoilLR", foil_s, slice_mat);
+    // Setting slice attributes
+    std::string foilVis = renderComp ? "LFHCALLayerSepVis" : "InvisibleNoDaughters";
+    plate.foilgrid.setAttributes(desc, region, limit, foilVis);
+    plate.foil_tb.setAttributes(desc, region, limit, foilVis);
+    plate.foil_lr.setAttributes(desc, region, limit, foilVis);
+    plate.tower = createScintillatorTower(desc, platename + "_tower", w_tow, h_tow, t_slice,
+                                          slice_mat, region, limit, vis, sens, renderComp);
   }
-  pvm = modScintAssembly.placeVolume(foilgrid_vol, Position(0, 0, 0));
-  pvm = modScintAssembly.placeVolume(foil_t_vol, Position(0, 1.5 * t_foil + h_tow, 0));
-  pvm = modScintAssembly.placeVolume(foil_b_vol, Position(0, -(1.5 * t_foil + h_tow), 0));
-  pvm = modScintAssembly.placeVolume(foil_l_vol, Position(-(1.5 * t_foil + w_tow), 0, 0));
-  pvm = modScintAssembly.placeVolume(foil_r_vol, Position((1.5 * t_foil + w_tow), 0, 0));
+  pvm = modScintAssembly.placeVolume(plate.foilgrid, Position(0, 0, 0));
+  pvm = modScintAssembly.placeVolume(plate.foil_tb, Position(0, 1.5 * t_foil + h_tow, 0));
+  pvm = modScintAssembly.placeVolume(plate.foil_tb, Position(0, -(1.5 * t_foil + h_tow), 0));
+  pvm = modScintAssembly.placeVolume(plate.foil_lr, Position(-(1.5 * t_foil + w_tow), 0, 0));
+  pvm = modScintAssembly.placeVolume(plate.foil_lr, Position((1.5 * t_foil + w_tow), 0, 0));
 
   // 4M module placement of scintillator for tower
   double rotZ[4] = {0, 0, 0, 0};
@@ -439,11 +451,8 @@ Assembly createScintillatorPlateFourM(Detector& desc, std::string basename,
 
   for (int i = 0; i < 4; i++) {
     // printout(DEBUG, "LFHCAL_geo", basename + _toString(i, "_tower_%d") + "\t" + _toString(modID) + "\t" + _toString(i) + "\t" + _toString(layerID));
-    Volume modScintTowerAss =
-        createScintillatorTower(desc, basename + _toString(i, "_tower_%d"), w_tow, h_tow, t_slice,
-                                slice_mat, region, limit, vis, sens, renderComp);
     pvm = modScintAssembly.placeVolume(
-        modScintTowerAss,
+        plate.tower,
         Transform3D(RotationZYX(rotZ[i], rotY[i], rotX[i]), Position(posX[i], posY[i], posZ[i])));
     towerx = i % 2;
     towery = 0;
@@ -458,13 +467,116 @@ Assembly createScintillatorPlateFourM(Detector& desc, std::string basename,
   return modScintAssembly;
 }
 
+//************************************************************************************************************
+//************************** homogenized readout layers  *****************************************************
+//************************************************************************************************************
+void placeHomogenizedLayers(Detector& desc, Volume vol_mod, std::string basename,
+                            const moduleParamsStrct& mod_params,
+                            const std::vector<sliceParamsStrct>& sl_params, int nTowX, int nTowY,
+                            double length, SensitiveDetector sens, bool renderComp) {
+  double w_plate = mod_params.mod_width - 2 * mod_params.mod_SWThick - mod_params.mod_notchDepth;
+  double h_plate = mod_params.mod_height - 2 * mod_params.mod_TWThick;
+  double w_tow   = w_plate / nTowX;
+  double h_tow   = h_plate / nTowY;
+
+  // slab volumes shared between readout layers with identical composition
+  std::map<std::pair<std::string, bool>, Volume> slabVolumes;
+
+  double slice_z = -length / 2 + mod_params.mod_FWThick;
+  size_t first   = 0;
+  while (first < sl_params.size()) {
+    // readout layers are runs of slices with the same readout layer
+    size_t last = first;
+    while (last + 1 < sl_params.size() &&
+           sl_params[last + 1].slice_readoutLayer == sl_params[first].slice_readoutLayer)
+      last++;
+
+    epic::calorimeter::SliceStack composition;
+    double thick       = 0.;
+    bool sensitive     = false;
+    std::string visStr = sl_params[first].slice_visStr;
+    std::string regStr = sl_params[first].slice_regStr;
+    std::string limStr = sl_params[first].slice_limStr;
+    for (size_t i = first; i <= last; i++) {
+      if (sl_params[i].slice_offset > 0.)
+        composition["Air"] += sl_params[i].slice_offset;
+      composition[sl_params[i].slice_matStr] += sl_params[i].slice_thick;
+      thick += sl_params[i].slice_offset + sl_params[i].slice_thick;
+      if (sl_params[i].slice_partID == 3) {
+        sensitive = true;
+        visStr    = sl_params[i].slice_visStr;
+        regStr    = sl_params[i].slice_regStr;
+        limStr    = sl_params[i].slice_limStr;
+      }
+    }
+    Material slab_mat = epic::calorimeter::sliceStackMixture(desc, composition, "LFHCAL_Mix");
+    double slab_z     = slice_z + thick / 2.;
+
+    Volume& slab_vol = slabVolumes[{slab_mat.name(), sensitive}];
+    if (!slab_vol.isValid()) {
+      Box slab = sensitive ? Box(w_tow / 2., h_tow / 2., thick / 2.)
+                           : Box(w_plate / 2., h_plate / 2., thick / 2.);
+      slab_vol = Volume(basename + "_Slab" + _toString((int)slabVolumes.size(), "_%d"), slab,
+                        slab_mat);
+      if (sensitive) {
+        sens.setType("calorimeter");
+        slab_vol.setSensitiveDetector(sens);
+      }
+      slab_vol.setAttributes(desc, regStr, limStr, renderComp ? visStr : "InvisibleNoDaughters");
+    }
+
+    if (sensitive) {
+      // same tower numbering as the scintillator plates
+      for (int ty = 0; ty < nTowY; ty++) {
+        for (int tx = 0; tx < nTowX; tx++) {
+          Position tpos(mod_params.mod_notchDepth / 2. + (nTowX / 2. - tx - 0.5) * w_tow,
+                        (nTowY / 2. - ty - 0.5) * h_tow, slab_z);
+          PlacedVolume pvm = vol_mod.placeVolume(slab_vol, tpos);
+          pvm.addPhysVolID("towerx", tx)
+              .addPhysVolID("towery", ty)
+              .addPhysVolID("layerz", sl_params[first].layer_ID)
+              .addPhysVolID("passive", 0)
+              .addPhysVolID("rlayerz", sl_params[first].slice_readoutLayer);
+        }
+      }
+    } else {
+      vol_mod.placeVolume(slab_vol, Position(mod_params.mod_notchDepth / 2., 0., slab_z));
+    }
+    slice_z += thick;
+    first = last + 1;
+  }
+}
+
+// Scintillator mass fraction of the homogenized slab of each readout layer, by readout layer. The
+// slabs are sensitive as a whole, so their hits include the absorber deposits.
+std::map<int, double> scintillatorMassFractions(Detector& desc,
+                                                const std::vector<sliceParamsStrct>& sl_params) {
+  double rho_air = desc.material("Air")->GetMaterial()->GetDensity();
+  std::map<int, std::pair<double, double>> masses; // scintillator and total mass per unit area
+  for (const auto& sl : sl_params) {
+    double rho_slice         = desc.material(sl.slice_matStr)->GetMaterial()->GetDensity();
+    double slice_mass        = rho_slice * sl.slice_thick;
+    auto& [scint_mass, mass] = masses[sl.slice_readoutLayer];
+    mass += slice_mass + rho_air * sl.slice_offset;
+    if (sl.slice_partID == 3)
+      scint_mass += slice_mass;
+  }
+  std::map<int, double> fractions;
+  for (const auto& [rlayer, m] : masses) {
+    if (m.first > 0.)
+      fractions[rlayer] = m.first / m.second;
+  }
+  return fractions;
+}
+
 //************************************************************************************************************
 //************************** create 8M module assembly  ******************************************************
 //************************************************************************************************************
 Volume createEightMModule(Detector& desc, moduleParamsStrct mod_params,
                           std::vector<sliceParamsStrct> sl_params,
                           //                               int modID,
-                          double length, SensitiveDetector sens, bool renderComp, bool allSen) {
+                          double length, SensitiveDetector sens, bool renderComp, bool allSen,
+                          bool homogenized) {
   std::string baseName = "LFHCAL_8M";
 
   // assembly definition
@@ -555,76 +667,95 @@ Volume createEightMModule(Detector& desc, moduleParamsStrct mod_params,
                              "InvisibleNoDaughters");
   }
 
+  // slice volumes shared between layers with identical slices
+  std::map<sliceKey, Volume> absVolumes;
+  std::map<sliceKey, Volume> fillVolumes;
+  std::map<sliceKey, scintPlateStrct> scintPlates;
+
   int layer_num  = 0;
   double slice_z = -length / 2 + mod_params.mod_FWThick; // Keeps track of layers' local z locations
-  // Looping through the number of repeated layers & slices in each section
-  for (int i = 0; i < (int)sl_params.size(); i++) {
-    slice_z += sl_params[i].slice_offset +
-               sl_params[i].slice_thick / 2.; // Going to halfway point in layer
-    layer_num = sl_params[i].layer_ID;
-    //*************************************************
-    // absorber plates
-    //*************************************************
-    Material slice_mat = desc.material(sl_params[i].slice_matStr);
-    if (sl_params[i].slice_partID == 1) {
-      Volume modAbsAssembly = createAbsorberPlate(
-          desc, baseName + "_Abs" + _toString(sl_params[i].layer_ID, "_layer_%d"),
-          mod_params.mod_height, mod_params.mod_width, mod_params.mod_TWThick,
-          mod_params.mod_SWThick, sl_params[i].slice_thick, mod_params.mod_notchDepth,
-          mod_params.mod_notchHeight, slice_mat, sl_params[i].slice_regStr,
-          sl_params[i].slice_limStr, sl_params[i].slice_visStr, renderComp);
-      // Placing slice within layer
-      if (allSen)
-        modAbsAssembly.setSensitiveDetector(sens);
-      pvm = vol_mod.placeVolume(modAbsAssembly,
-                                Transform3D(RotationZYX(0, 0, 0), Position(0., 0., slice_z)));
-      if (allSen)
-        pvm.addPhysVolID("towerx", 0)
-            .addPhysVolID("towery", 0)
-            .addPhysVolID("rlayerz", sl_params[i].slice_readoutLayer)
-            .addPhysVolID("layerz", layer_num)
-            .addPhysVolID("passive", 1);
-      //*************************************************
-      // air & kapton & PCB & ESR
-      //*************************************************
-    } else if (sl_params[i].slice_partID == 2) {
-      Volume modFillAssembly =
-          createFillerPlate(desc,
-                            baseName + "_Fill" + _toString(sl_params[i].layer_ID, "_layer_%d") +
-                                _toString(sl_params[i].slice_ID, "slice_%d"),
-                            mod_params.mod_height, mod_params.mod_width, mod_params.mod_TWThick,
-                            mod_params.mod_SWThick, sl_params[i].slice_thick,
-                            mod_params.mod_notchDepth, slice_mat, sl_params[i].slice_regStr,
-                            sl_params[i].slice_limStr, sl_params[i].slice_visStr, renderComp);
-      // Placing slice within layer
-      if (allSen)
-        modFillAssembly.setSensitiveDetector(sens);
-      pvm = vol_mod.placeVolume(
-          modFillAssembly, Transform3D(RotationZYX(0, 0, 0),
-                                       Position((mod_params.mod_notchDepth) / 2., 0., slice_z)));
-      if (allSen)
-        pvm.addPhysVolID("towerx", 1)
-            .addPhysVolID("towery", 0)
-            .addPhysVolID("rlayerz", sl_params[i].slice_readoutLayer)
-            .addPhysVolID("layerz", layer_num)
-            .addPhysVolID("passive", 1);
+  if (homogenized) {
+    // one mixture slab per tower and readout layer instead of the slice stack
+    placeHomogenizedLayers(desc, vol_mod, baseName, mod_params, sl_params, 4, 2, length, sens,
+                           renderComp);
+    layer_num = sl_params.back().layer_ID;
+  } else {
+    // Looping through the number of repeated layers & slices in each section
+    for (int i = 0; i < (int)sl_params.size(); i++) {
+      slice_z += sl_params[i].slice_offset +
+                 sl_params[i].slice_thick / 2.; // Going to halfway point in layer
+      layer_num = sl_params[i].layer_ID;
       //*************************************************
-      // scintillator
+      // absorber plates
       //*************************************************
-    } else {
-      Assembly modScintAssembly = createScintillatorPlateEightM(
-          desc, baseName + "_ScintAssembly" + _toString(sl_params[i].layer_ID, "_layer_%d"),
-          layer_num, mod_params.mod_height, mod_params.mod_width, mod_params.mod_TWThick,
-          mod_params.mod_SWThick, sl_params[i].slice_thick, mod_params.mod_notchDepth,
-          mod_params.mod_foilThick, slice_mat, sl_params[i].slice_readoutLayer,
-          sl_params[i].slice_regStr, sl_params[i].slice_limStr, sl_params[i].slice_visStr, sens,
-          renderComp);
-      // Placing slice within layer
-      pvm = vol_mod.placeVolume(
-          modScintAssembly, Transform3D(RotationZYX(0, 0, 0),
-                                        Position((mod_params.mod_notchDepth) / 2., 0, slice_z)));
+      Material slice_mat = desc.material(sl_params[i].slice_matStr);
+      sliceKey slice_key = getSliceKey(sl_params[i]);
+      if (sl_params[i].slice_partID == 1) {
+        Volume& modAbsAssembly = absVolumes[slice_key];
+        if (!modAbsAssembly.isValid()) {
+          modAbsAssembly = createAbsorberPlate(
+              desc, baseName + "_Abs" + _toString((int)absVolumes.size(), "_%d"),
+              mod_params.mod_height, mod_params.mod_width, mod_params.mod_TWThick,
+              mod_params.mod_SWThick, sl_params[i].slice_thick, mod_params.mod_notchDepth,
+              mod_params.mod_notchHeight, slice_mat, sl_params[i].slice_regStr,
+              sl_params[i].slice_limStr, sl_params[i].slice_visStr, renderComp);
+          if (allSen)
+            modAbsAssembly.setSensitiveDetector(sens);
+        }
+        // Placing slice within layer
+        pvm = vol_mod.placeVolume(modAbsAssembly,
+                                  Transform3D(RotationZYX(0, 0, 0), Position(0., 0., slice_z)));
+        if (allSen)
+          pvm.addPhysVolID("towerx", 0)
+              .addPhysVolID("towery", 0)
+              .addPhysVolID("rlayerz", sl_params[i].slice_readoutLayer)
+              .addPhysVolID("layerz", layer_num)
+              .addPhysVolID("passive", 1);
+        //*************************************************
+        // air & kapton & PCB & ESR
+        //*************************************************
+      } else if (sl_params[i].slice_partID == 2) {
+        Volume& modFillAssembly = fillVolumes[slice_key];
+        if (!modFillAssembly.isValid()) {
+          modFillAssembly = createFillerPlate(
+              desc, baseName + "_Fill" + _toString((int)fillVolumes.size(), "_%d"),
+              mod_params.mod_height, mod_params.mod_width, mod_params.mod_TWThick,
+              mod_params.mod_SWThick, sl_params[i].slice_thick, mod_params.mod_notchDepth,
+              slice_mat, sl_params[i].slice_regStr, sl_params[i].slice_limStr,
+              sl_params[i].slice_visStr, renderComp);
+          if (allSen)
+            modFillAssembly.setSensitiveDetector(sens);
+        }
+        // Placing slice within layer
+        pvm = vol_mod.placeVolume(
+            modFillAssembly, Transform3D(RotationZYX(0, 0, 0),
+                                         Position((mod_params.mod_notchDepth) / 2., 0., slice_z)));
+        if (allSen)
+          pvm.addPhysVolID("towerx", 1)
+              .addPhysVolID("towery", 0)
+              .addPhysVolID("rlayerz", sl_params[i].slice_readoutLayer)
+              .addPhysVolID("layerz", layer_num)
+              .addPhysVolID("passive", 1);
+        //*************************************************
+        // scintillator
+        //*************************************************
+      } else {
+        scintPlateStrct& plate    = scintPlates[slice_key];
+        Assembly modScintAssembly = createScintillatorPlateEightM(
+            desc, baseName + "_ScintAssembly" + _toString(sl_params[i].layer_ID, "_layer_%d"),
+            baseName + "_Scint" + _toString((int)scintPlates.size(), "_%d"), plate, layer_num,
+            mod_params.mod_height, mod_params.mod_width, mod_params.mod_TWThick,
+            mod_params.mod_SWThick, sl_params[i].slice_thick, mod_params.mod_notchDepth,
+            mod_params.mod_foilThick, slice_mat, sl_params[i].slice_readoutLayer,
+            sl_params[i].slice_regStr, sl_params[i].slice_limStr, sl_params[i].slice_visStr, sens,
+            renderComp);
+        // Placing slice within layer
+        pvm = vol_mod.placeVolume(
+            modScintAssembly, Transform3D(RotationZYX(0, 0, 0),
+                                          Position((mod_params.mod_notchDepth) / 2., 0, slice_z)));
+      }
+      slice_z += sl_params[i].slice_thick / 2.;
     }
-    slice_z += sl_params[i].slice_thick / 2.;
   }
 
   // placement 8M module casing
@@ -694,7 +825,8 @@ Volume createEightMModule(Detector& desc, moduleParamsStrct mod_params,
 Volume createFourMModule(Detector& desc, moduleParamsStrct mod_params,
                          std::vector<sliceParamsStrct> sl_params,
                          //                               int modID,
-                         double length, SensitiveDetector sens, bool renderComp, bool allSen) {
+                         double length, SensitiveDetector sens, bool renderComp, bool allSen,
+                         bool homogenized) {
 
   std::string baseName = "LFHCAL_4M";
 
@@ -787,77 +919,96 @@ Volume createFourMModule(Detector& desc, moduleParamsStrct mod_params,
                              "InvisibleNoDaughters");
   }
 
+  // slice volumes shared between layers with identical slices
+  std::map<sliceKey, Volume> absVolumes;
+  std::map<sliceKey, Volume> fillVolumes;
+  std::map<sliceKey, scintPlateStrct> scintPlates;
+
   int layer_num  = 0;
   double slice_z = -length / 2 + mod_params.mod_FWThick; // Keeps track of layers' local z locations
 
-  // Looping through the number of repeated layers & slices in each section
-  for (int i = 0; i < (int)sl_params.size(); i++) {
-    slice_z += sl_params[i].slice_offset +
-               sl_params[i].slice_thick / 2.; // Going to halfway point in layer
-    layer_num = sl_params[i].layer_ID;
-    //*************************************************
-    // absorber plates
-    //*************************************************
-    Material slice_mat = desc.material(sl_params[i].slice_matStr);
-    if (sl_params[i].slice_partID == 1) {
-      Volume modAbsAssembly = createAbsorberPlate(
-          desc, baseName + "_Abs" + _toString(sl_params[i].layer_ID, "_layer_%d"),
-          mod_params.mod_height, mod_params.mod_width, mod_params.mod_TWThick,
-          mod_params.mod_SWThick, sl_params[i].slice_thick, mod_params.mod_notchDepth,
-          mod_params.mod_notchHeight, slice_mat, sl_params[i].slice_regStr,
-          sl_params[i].slice_limStr, sl_params[i].slice_visStr, renderComp);
-      // Placing slice within layer
-      if (allSen)
-        modAbsAssembly.setSensitiveDetector(sens);
-      pvm = vol_mod.placeVolume(modAbsAssembly,
-                                Transform3D(RotationZYX(0, 0, 0), Position(0., 0., slice_z)));
-      if (allSen)
-        pvm.addPhysVolID("towerx", 0)
-            .addPhysVolID("towery", 0)
-            .addPhysVolID("rlayerz", sl_params[i].slice_readoutLayer)
-            .addPhysVolID("layerz", layer_num)
-            .addPhysVolID("passive", 1);
-      //*************************************************
-      // air & kapton & PCB & ESR
-      //*************************************************
-    } else if (sl_params[i].slice_partID == 2) {
-      Volume modFillAssembly =
-          createFillerPlate(desc,
-                            baseName + "_Fill" + _toString(sl_params[i].layer_ID, "_layer_%d") +
-                                _toString(sl_params[i].slice_ID, "slice_%d"),
-                            mod_params.mod_height, mod_params.mod_width, mod_params.mod_TWThick,
-                            mod_params.mod_SWThick, sl_params[i].slice_thick,
-                            mod_params.mod_notchDepth, slice_mat, sl_params[i].slice_regStr,
-                            sl_params[i].slice_limStr, sl_params[i].slice_visStr, renderComp);
-      // Placing slice within layer
-      if (allSen)
-        modFillAssembly.setSensitiveDetector(sens);
-      pvm = vol_mod.placeVolume(
-          modFillAssembly, Transform3D(RotationZYX(0, 0, 0),
-                                       Position((mod_params.mod_notchDepth) / 2., 0., slice_z)));
-      if (allSen)
-        pvm.addPhysVolID("towerx", 1)
-            .addPhysVolID("towery", 0)
-            .addPhysVolID("rlayerz", sl_params[i].slice_readoutLayer)
-            .addPhysVolID("layerz", layer_num)
-            .addPhysVolID("passive", 1);
+  if (homogenized) {
+    // one mixture slab per tower and readout layer instead of the slice stack
+    placeHomogenizedLayers(desc, vol_mod, baseName, mod_params, sl_params, 2, 2, length, sens,
+                           renderComp);
+    layer_num = sl_params.back().layer_ID;
+  } else {
+    // Looping through the number of repeated layers & slices in each section
+    for (int i = 0; i < (int)sl_params.size(); i++) {
+      slice_z += sl_params[i].slice_offset +
+                 sl_params[i].slice_thick / 2.; // Going to halfway point in layer
+      layer_num = sl_params[i].layer_ID;
       //*************************************************
-      // scintillator
+      // absorber plates
       //*************************************************
-    } else {
-      Assembly modScintAssembly = createScintillatorPlateFourM(
-          desc, baseName + "_ScintAssembly" + _toString(sl_params[i].layer_ID, "_layer_%d"),
-          layer_num, mod_params.mod_height, mod_params.mod_width, mod_params.mod_TWThick,
-          mod_params.mod_SWThick, sl_params[i].slice_thick, mod_params.mod_notchDepth,
-          mod_params.mod_foilThick, slice_mat, sl_params[i].slice_readoutLayer,
-          sl_params[i].slice_regStr, sl_params[i].slice_limStr, sl_params[i].slice_visStr, sens,
-          renderComp);
-      // Placing slice within layer
-      pvm = vol_mod.placeVolume(
-          modScintAssembly, Transform3D(RotationZYX(0, 0, 0),
-                                        Position((mod_params.mod_notchDepth) / 2., 0, slice_z)));
+      Material slice_mat = desc.material(sl_params[i].slice_matStr);
+      sliceKey slice_key = getSliceKey(sl_params[i]);
+      if (sl_params[i].slice_partID == 1) {
+        Volume& modAbsAssembly = absVolumes[slice_key];
+        if (!modAbsAssembly.isValid()) {
+          modAbsAssembly = createAbsorberPlate(
+              desc, baseName + "_Abs" + _toString((int)absVolumes.size(), "_%d"),
+              mod_params.mod_height, mod_params.mod_width, mod_params.mod_TWThick,
+              mod_params.mod_SWThick, sl_params[i].slice_thick, mod_params.mod_notchDepth,
+              mod_params.mod_notchHeight, slice_mat, sl_params[i].slice_regStr,
+              sl_params[i].slice_limStr, sl_params[i].slice_visStr, renderComp);
+          if (allSen)
+            modAbsAssembly.setSensitiveDetector(sens);
+        }
+        // Placing slice within layer
+        pvm = vol_mod.placeVolume(modAbsAssembly,
+                                  Transform3D(RotationZYX(0, 0, 0), Position(0., 0., slice_z)));
+        if (allSen)
+          pvm.addPhysVolID("towerx", 0)
+              .addPhysVolID("towery", 0)
+              .addPhysVolID("rlayerz", sl_params[i].slice_readoutLayer)
+              .addPhysVolID("layerz", layer_num)
+              .addPhysVolID("passive", 1);
+        //*************************************************
+        // air & kapton & PCB & ESR
+        //*************************************************
+      } else if (sl_params[i].slice_partID == 2) {
+        Volume& modFillAssembly = fillVolumes[slice_key];
+        if (!modFillAssembly.isValid()) {
+          modFillAssembly = createFillerPlate(
+              desc, baseName + "_Fill" + _toString((int)fillVolumes.size(), "_%d"),
+              mod_params.mod_height, mod_params.mod_width, mod_params.mod_TWThick,
+              mod_params.mod_SWThick, sl_params[i].slice_thick, mod_params.mod_notchDepth,
+              slice_mat, sl_params[i].slice_regStr, sl_params[i].slice_limStr,
+              sl_params[i].slice_visStr, renderComp);
+          if (allSen)
+            modFillAssembly.setSensitiveDetector(sens);
+        }
+        // Placing slice within layer
+        pvm = vol_mod.placeVolume(
+            modFillAssembly, Transform3D(RotationZYX(0, 0, 0),
+                                         Position((mod_params.mod_notchDepth) / 2., 0., slice_z)));
+        if (allSen)
+          pvm.addPhysVolID("towerx", 1)
+              .addPhysVolID("towery", 0)
+              .addPhysVolID("rlayerz", sl_params[i].slice_readoutLayer)
+              .addPhysVolID("layerz", layer_num)
+              .addPhysVolID("passive", 1);
+        //*************************************************
+        // scintillator
+        //*************************************************
+      } else {
+        scintPlateStrct& plate    = scintPlates[slice_key];
+        Assembly modScintAssembly = createScintillatorPlateFourM(
+            desc, baseName + "_ScintAssembly" + _toString(sl_params[i].layer_ID, "_layer_%d"),
+            baseName + "_Scint" + _toString((int)scintPlates.size(), "_%d"), plate, layer_num,
+            mod_params.mod_height, mod_params.mod_width, mod_params.mod_TWThick,
+            mod_params.mod_SWThick, sl_params[i].slice_thick, mod_params.mod_notchDepth,
+            mod_params.mod_foilThick, slice_mat, sl_params[i].slice_readoutLayer,
+            sl_params[i].slice_regStr, sl_params[i].slice_limStr, sl_params[i].slice_visStr, sens,
+            renderComp);
+        // Placing slice within layer
+        pvm = vol_mod.placeVolume(
+            modScintAssembly, Transform3D(RotationZYX(0, 0, 0),
+                                          Position((mod_params.mod_notchDepth) / 2., 0, slice_z)));
+      }
+      slice_z += sl_params[i].slice_thick / 2.;
     }
-    slice_z += sl_params[i].slice_thick / 2.;
   }
 
   // placement 4M module casing
@@ -920,6 +1071,93 @@ Volume createFourMModule(Detector& desc, moduleParamsStrct mod_params,
   return vol_mod;
 }
 
+//************************************************************************************************************
+//************************** read explicit list of module positions ******************************************
+//************************************************************************************************************
+void readModulePositions(xml_coll_t positions, std::vector<modulePosStrct>& pos) {
+  for (xml_coll_t position_i(positions, _U(position)); position_i; ++position_i) {
+    xml_comp_t position_comp = position_i;
+    if (!getAttrOrDefault(position_comp, _Unicode(if), true)) {
+      printout(DEBUG, "LFHCAL_geo", "skipping x = %.1f cm, y = %.1f cm", position_comp.x(),
+               position_comp.y());
+      continue;
+    }
+    pos.push_back({position_comp.x(), position_comp.y(), position_comp.z()});
+  }
+}
+
+//************************************************************************************************************
+//************************** expand module layout into 8M and 4M module positions ****************************
+//************************************************************************************************************
+void expandModuleLayout(xml_comp_t x_layout, double width8M, double width4M, double height,
+                        std::vector<modulePosStrct>& pos8M, std::vector<modulePosStrct>& pos4M) {
+  double stagger = getAttrOrDefault(x_layout, _Unicode(stagger), 0.);
+  double split   = getAttrOrDefault(x_layout, _Unicode(split), 0.);
+  double z       = getAttrOrDefault(x_layout, _Unicode(z), 0.);
+  double eps     = 1e-3 * width4M;
+
+  struct cutoutStrct {
+    double xmin, xmax, ymin, ymax;
+  };
+  std::vector<cutoutStrct> cutouts;
+  for (xml_coll_t c(x_layout, _Unicode(cutout)); c; ++c) {
+    xml_dim_t x_cutout = c;
+    if (!getAttrOrDefault(x_cutout, _Unicode(if), true))
+      continue;
+    cutouts.push_back({x_cutout.xmin(), x_cutout.xmax(), x_cutout.ymin(), x_cutout.ymax()});
+  }
+
+  for (xml_coll_t r(x_layout, _Unicode(row)); r; ++r) {
+    xml_dim_t x_row = r;
+    if (!getAttrOrDefault(x_row, _Unicode(if), true))
+      continue;
+    double y    = x_row.y();
+    double xmin = x_row.xmin();
+    double xmax = x_row.xmax();
+
+    // 8M modules are aligned to multiples of their width, shifted in every other row
+    long rowIndex = std::lround(y / height - 0.5);
+    double shift  = (rowIndex % 2 != 0) ? stagger : 0.;
+
+    // split the row into segments at the split line and at the edges of active cutouts
+    std::vector<double> edges = {xmin, xmax, split};
+    std::vector<cutoutStrct> rowCutouts;
+    for (const auto& cut : cutouts) {
+      if (y > cut.ymin && y < cut.ymax) {
+        rowCutouts.push_back(cut);
+        edges.push_back(cut.xmin);
+        edges.push_back(cut.xmax);
+      }
+    }
+    std::sort(edges.begin(), edges.end());
+    for (size_t s = 0; s + 1 < edges.size(); s++) {
+      double x0 = std::max(edges[s], xmin);
+      double x1 = std::min(edges[s + 1], xmax);
+      if (x1 - x0 < eps)
+        continue;
+      double xmid = 0.5 * (x0 + x1);
+      auto inCutout = [xmid](const cutoutStrct& cut) {
+        return xmid > cut.xmin && xmid < cut.xmax;
+      };
+      if (std::any_of(rowCutouts.begin(), rowCutouts.end(), inCutout))
+        continue;
+
+      // fill the segment from low x, with 4M modules where no aligned 8M module fits
+      double x = x0;
+      while (x1 - x > eps) {
+        bool aligned = std::abs(std::remainder(x - shift, width8M)) < eps;
+        if (aligned && x + width8M < x1 + eps) {
+          pos8M.push_back({x, y, z});
+          x += width8M;
+        } else {
+          pos4M.push_back({x, y, z});
+          x += width4M;
+        }
+      }
+    }
+  }
+}
+
 //********************************************************************************************
 //*                                                                                          *
 //*                              Create detector                                             *
@@ -951,6 +1189,10 @@ static Ref_t createDetector(Detector& desc, xml_h handle, SensitiveDetector sens
 
   bool renderComponents = getAttrOrDefault(detElem, _Unicode(renderComponents), 0.);
   bool allSensitive     = getAttrOrDefault(detElem, _Unicode(allSensitive), 0.);
+  bool homogenized      = epic::calorimeter::homogenizedMode(detElem, "LFHCAL_geo");
+  if (homogenized) {
+    printout(INFO, "LFHCAL_geo", "homogenized readout layers");
+  }
   if (renderComponents) {
     printout(DEBUG, "LFHCAL_geo", "enabled visualization");
   } else {
@@ -1025,6 +1267,16 @@ static Ref_t createDetector(Detector& desc, xml_h handle, SensitiveDetector sens
     }
   }
 
+  if (homogenized) {
+    // starting point for the sampling fraction calibration of the homogenized readout layers
+    for (const auto& [rlayer, fraction] : scintillatorMassFractions(desc, slice_Params)) {
+      desc.add(Constant(detName + _toString(rlayer, "_rlayerz%d_ScintillatorMassFraction"),
+                        _toString(fraction, "%.6f")));
+      printout(INFO, "LFHCAL_geo", "readout layer %d: scintillator mass fraction %.4f", rlayer,
+               fraction);
+    }
+  }
+
   // create mother volume
   DetElement det(detName, detID);
   Assembly assembly(detName);
@@ -1033,26 +1285,22 @@ static Ref_t createDetector(Detector& desc, xml_h handle, SensitiveDetector sens
   int moduleIDx = -1;
   int moduleIDy = -1;
 
-  struct position {
-    double x, y, z;
-  };
-
-  std::vector<position> pos8M;
-
-  xml_coll_t eightMPos(detElem, _Unicode(eightmodulepositions));
-  for (xml_coll_t position_i(eightMPos, _U(position)); position_i; ++position_i) {
-    xml_comp_t position_comp = position_i;
-    if (!getAttrOrDefault(position_comp, _Unicode(if), true)) {
-      printout(DEBUG, "LFHCAL_geo", "skipping x = %.1f cm, y = %.1f cm", position_comp.x(),
-               position_comp.y());
-      continue;
-    }
-    pos8M.push_back({position_comp.x(), position_comp.y(), position_comp.z()});
+  // module positions, expanded from the layout or read from explicit lists
+  std::vector<modulePosStrct> pos8M;
+  std::vector<modulePosStrct> pos4M;
+  if (detElem.hasChild(_Unicode(modulelayout))) {
+    expandModuleLayout(detElem.child(_Unicode(modulelayout)), eightM_params.mod_width,
+                       fourM_params.mod_width, eightM_params.mod_height, pos8M, pos4M);
+  } else {
+    readModulePositions(xml_coll_t(detElem, _Unicode(eightmodulepositions)), pos8M);
+    readModulePositions(xml_coll_t(detElem, _Unicode(fourmodulepositions)), pos4M);
   }
+  printout(DEBUG, "LFHCAL_geo", "LFHCAL module layout: %zu 8M modules, %zu 4M modules",
+           pos8M.size(), pos4M.size());
 
   // create 8M modules
   Volume eightMassembly = createEightMModule(desc, eightM_params, slice_Params, length, sens,
-                                             renderComponents, allSensitive);
+                                             renderComponents, allSensitive, homogenized);
   for (int e = 0; e < (int)pos8M.size(); e++) {
     if (e % 20 == 0)
       printout(DEBUG, "LFHCAL_geo",
@@ -1077,22 +1325,9 @@ static Ref_t createDetector(Detector& desc, xml_h handle, SensitiveDetector sens
         .addPhysVolID("moduletype", 0);
   }
 
-  std::vector<position> pos4M;
-
-  xml_coll_t fourMPos(detElem, _Unicode(fourmodulepositions));
-  for (xml_coll_t position_i(fourMPos, _U(position)); position_i; ++position_i) {
-    xml_comp_t position_comp = position_i;
-    if (!getAttrOrDefault(position_comp, _Unicode(if), true)) {
-      printout(DEBUG, "LFHCAL_geo", "skipping x = %.1f cm, y = %.1f cm", position_comp.x(),
-               position_comp.y());
-      continue;
-    }
-    pos4M.push_back({position_comp.x(), position_comp.y(), position_comp.z()});
-  }
-
   // create 4M modules
   Volume fourMassembly = createFourMModule(desc, fourM_params, slice_Params, length, sens,
-                                           renderComponents, allSensitive);
+                                           renderComponents, allSensitive, homogenized);
   for (int f = 0; f < (int)pos4M.size(); f++) {
     if (f % 20 == 0)
       printout(DEBUG, "LFHCAL_geo",
@@ -1125,4 +1360,4 @@ static Ref_t createDetector(Detector& desc, xml_h handle, SensitiveDetector sens
 
   return det;
 }
-DECLARE_DETELEMENT(epic_LFHCAL, createDetector)
+DECLARE_PROFILED_DETELEMENT(epic_LFHCAL, createDetector)
@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 ePIC Collaboration
+
+#pragma once
+
+#include "DD4hep/DetFactoryHelper.h"
+#include "DD4hep/Printout.h"
+#include "DD4hepDetectorHelper.h"
+#include "SliceMixture.h"
+
+#include <string>
+#include <vector>
+
+// Shared core of the layered (sampling) calorimeter builders
+//
+// - A LayerType is the volume of one <layer> with its slices, built once by buildSlices() (or
+//   buildHomogenizedSlices()) and placed as many times as the layer repeats by placeLayers().
+// - Each LayerType keeps its material budget, which a BudgetSummary reports per detector.
+namespace epic::calorimeter {
+
+// Material budget of one layer, in radiation lengths and nuclear interaction lengths, and its
+// mass per unit area (g/cm2) in all slices and in the sensitive ones
+struct LayerBudget {
+  std::string name;
+  int repeat            = 0;
+  double thickness      = 0.;
+  double x0             = 0.;
+  double lambda         = 0.;
+  double mass           = 0.;
+  double sensitive_mass = 0.;
+
+  void addSlice(const dd4hep::Material& material, double slice_thickness, bool sensitive = false) {
+    const double slice_mass = material->GetMaterial()->GetDensity() * slice_thickness / dd4hep::cm;
+    thickness += slice_thickness;
+    x0 += slice_thickness / material.radLength();
+    lambda += slice_thickness / material.intLength();
+    mass += slice_mass;
+    sensitive_mass += sensitive ? slice_mass : 0.;
+  }
+
+  double sensitiveMassFraction() const { return mass > 0. ? sensitive_mass / mass : 0.; }
+};
+
+// A layer volume with its sensitive slice placements and material budget
+struct LayerType {
+  dd4hep::Volume volume;
+  std::vector<dd4hep::PlacedVolume> sensitives;
+  LayerBudget budget;
+};
+
+// Fill layer.volume with the <slice>s of x_layer, stacked along z from the front of a layer of
+// the given thickness. The slice shapes come from make_shape(slice thickness), the slices are
+// named prefix + "slice<n>" and numbered from 1 in the "slice" volume ID.
+template <typename MakeShape>
+void buildSlices(dd4hep::Detector& desc, LayerType& layer, xml_comp_t x_layer,
+                 double layer_thickness, dd4hep::SensitiveDetector& sens, const std::string& prefix,
+                 MakeShape make_shape) {
+  int slice_num  = 1;
+  double slice_z = -layer_thickness / 2.;
+  for (xml_coll_t l(x_layer, _U(slice)); l; ++l, ++slice_num) {
+    xml_comp_t x_slice         = l;
+    double slice_thickness     = x_slice.thickness();
+    dd4hep::Material slice_mat = desc.material(x_slice.materialStr());
+    dd4hep::Volume slice_vol(prefix + _toString(slice_num, "slice%d"), make_shape(slice_thickness),
+                             slice_mat);
+    slice_vol.setAttributes(desc, x_slice.regionStr(), x_slice.limitsStr(), x_slice.visStr());
+
+    dd4hep::PlacedVolume pv = layer.volume.placeVolume(
+        slice_vol, dd4hep::Position(0., 0., slice_z + slice_thickness / 2.));
+    pv.addPhysVolID("slice", slice_num);
+    if (x_slice.isSensitive()) {
+      sens.setType("calorimeter");
+      slice_vol.setSensitiveDetector(sens);
+      layer.sensitives.push_back(pv);
+    }
+    layer.budget.addSlice(slice_mat, slice_thickness, x_slice.isSensitive());
+    slice_z += slice_thickness;
+  }
+}
+
+// Fill layer.volume with one volume of the slice stack mixture of x_layer (see SliceMixture.h),
+// as thick as the slices and at their place in the layer. It is sensitive if any slice is, and
+// takes the "slice" volume ID and the attributes of the first sensitive slice (or else of the
+// first slice), so that the readout of the layer keeps its IDs. Its hits include the deposits
+// in all slices; BudgetSummary::addMassFractions() exports the sensitive mass fraction.
+template <typename MakeShape>
+void buildHomogenizedSlices(dd4hep::Detector& desc, LayerType& layer, xml_comp_t x_layer,
+                            double layer_thickness, dd4hep::SensitiveDetector& sens,
+                            const std::string& prefix, MakeShape make_shape) {
+  xml_comp_t x_first = x_layer; // the first (sensitive) slice once first_num is set
+  int first_num      = 0;
+  int slice_num      = 1;
+  for (xml_coll_t l(x_layer, _U(slice)); l; ++l, ++slice_num) {
+    xml_comp_t x_slice = l;
+    layer.budget.addSlice(desc.material(x_slice.materialStr()), x_slice.thickness(),
+                          x_slice.isSensitive());
+    if (first_num == 0 || (x_slice.isSensitive() && !x_first.isSensitive())) {
+      x_first   = x_slice;
+      first_num = slice_num;
+    }
+  }
+  if (first_num == 0) {
+    return;
+  }
+
+  double stack_thickness = layer.budget.thickness;
+  dd4hep::Material mix   = sliceStackMixture(desc, sliceStack(x_layer), "Layer_Mix");
+  dd4hep::Volume slice_vol(prefix + _toString(first_num, "slice%d"), make_shape(stack_thickness),
+                           mix);
+  slice_vol.setAttributes(desc, x_first.regionStr(), x_first.limitsStr(), x_first.visStr());
+
+  dd4hep::PlacedVolume pv = layer.volume.placeVolume(
+      slice_vol, dd4hep::Position(0., 0., -layer_thickness / 2. + stack_thickness / 2.));
+  pv.addPhysVolID("slice", first_num);
+  if (x_first.isSensitive()) {
+    sens.setType("calorimeter");
+    slice_vol.setSensitiveDetector(sens);
+    layer.sensitives.push_back(pv);
+  }
+}
+
+// Place a layer type repeat times along z, the first one centered at z_first and the next ones
+// every pitch, with consecutive "layer" volume IDs from first_id
+inline std::vector<dd4hep::PlacedVolume> placeLayers(dd4hep::Volume& mother, const LayerType& layer,
+                                                     int repeat, double z_first, double pitch,
+                                                     int first_id) {
+  std::vector<dd4hep::PlacedVolume> placements;
+  placements.reserve(repeat);
+  for (int i = 0; i < repeat; ++i) {
+    dd4hep::PlacedVolume pv =
+        mother.placeVolume(layer.volume, dd4hep::Position(0., 0., z_first + i * pitch));
+    pv.addPhysVolID("layer", first_id + i);
+    placements.push_back(pv);
+  }
+  return placements;
+}
+
+// Per layer type material budget of a detector
+class BudgetSummary {
+public:
+  void add(const LayerBudget& budget) { m_budgets.push_back(budget); }
+
+  // Print the summary (per layer type and totals, at DEBUG), and publish it in the
+  // parameters of the detector element:
+  // layer_type<i>_{name,repeat,thickness,x0,lambda,sensitive_mass_fraction} and
+  // total_{thickness,x0,lambda}
+  void report(dd4hep::DetElement& det, const std::string& source) const {
+    auto& params = DD4hepDetectorHelper::ensureExtension<dd4hep::rec::VariantParameters>(det);
+
+    double thickness = 0., x0 = 0., lambda = 0.;
+    for (size_t i = 0; i < m_budgets.size(); ++i) {
+      const LayerBudget& b = m_budgets[i];
+      dd4hep::printout(dd4hep::DEBUG, source,
+                       "%s: %d x %s, %.2f mm, %.3f X0, %.3f lambda per layer", det.name(),
+                       b.repeat, b.name.c_str(), b.thickness / dd4hep::mm, b.x0, b.lambda);
+      const std::string key = _toString(int(i), "layer_type%d_");
+      params.set<std::string>(key + "name", b.name);
+      params.set<int>(key + "repeat", b.repeat);
+      params.set<double>(key + "thickness", b.thickness);
+      params.set<double>(key + "x0", b.x0);
+      params.set<double>(key + "lambda", b.lambda);
+      params.set<double>(key + "sensitive_mass_fraction", b.sensitiveMassFraction());
+      thickness += b.repeat * b.thickness;
+      x0 += b.repeat * b.x0;
+      lambda += b.repeat * b.lambda;
+    }
+    params.set<double>("total_thickness", thickness);
+    params.set<double>("total_x0", x0);
+    params.set<double>("total_lambda", lambda);
+    dd4hep::printout(dd4hep::DEBUG, source, "%s: %zu layer types, %.2f mm, %.2f X0, %.2f lambda",
+                     det.name(), m_budgets.size(), thickness / dd4hep::mm, x0, lambda);
+  }
+
+  // Add the constant <layer type name>_SensitiveMassFraction per layer type with a sensitive
+  // slice, as a starting point for the sampling fraction calibration of homogenized layers,
+  // whose hits include the deposits in all slices
+  void addMassFractions(dd4hep::Detector& desc, const std::string& source) const {
+    for (const LayerBudget& b : m_budgets) {
+      if (b.sensitive_mass > 0.) {
+        desc.add(dd4hep::Constant(b.name + "_SensitiveMassFraction",
+                                  _toString(b.sensitiveMassFraction(), "%.6f")));
+        dd4hep::printout(dd4hep::INFO, source, "%s: homogenized, sensitive mass fraction %.4f",
+                         b.name.c_str(), b.sensitiveMassFraction());
+      }
+    }
+  }
+
+private:
+  std::vector<LayerBudget> m_budgets;
+};
+
+} // namespace epic::calorimeter
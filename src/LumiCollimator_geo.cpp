@@ -9,6 +9,7 @@
 
 #include "DD4hep/DetFactoryHelper.h"
 #include <XML/Helper.h>
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -66,4 +67,4 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector /
   return sdet;
 }
 
-DECLARE_DETELEMENT(LumiCollimator, create_detector)
+DECLARE_PROFILED_DETELEMENT(LumiCollimator, create_detector)
@@ -8,6 +8,7 @@
 #include "DDRec/Surface.h"
 #include "XML/Layering.h"
 #include <XML/Helper.h>
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -49,4 +50,4 @@ static Ref_t create_detector(Detector& desc, xml_h e, SensitiveDetector sens) {
   return det;
 }
 
-DECLARE_DETELEMENT(LumiDirectPCAL, create_detector)
+DECLARE_PROFILED_DETELEMENT(LumiDirectPCAL, create_detector)
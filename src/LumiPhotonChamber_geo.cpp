@@ -8,6 +8,7 @@
 #include "DDRec/Surface.h"
 #include "XML/Layering.h"
 #include <XML/Helper.h>
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -101,4 +102,4 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector /
   return det;
 }
 
-DECLARE_DETELEMENT(LumiPhotonChamber, create_detector)
+DECLARE_PROFILED_DETELEMENT(LumiPhotonChamber, create_detector)
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <iostream>
 #include <tuple>
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -106,4 +107,4 @@ static tuple<Volume, Position> build_specHomoCAL_module(const Detector& descript
   return make_tuple(modVol, Position{sx, sy, sz});
 }
 
-DECLARE_DETELEMENT(LumiSpecHomoCAL, create_detector) //(det_type, driver func)
+DECLARE_PROFILED_DETELEMENT(LumiSpecHomoCAL, create_detector) //(det_type, driver func)
@@ -4,6 +4,7 @@
 #include "DD4hep/DetFactoryHelper.h"
 #include "DD4hep/Printout.h"
 #include <XML/Helper.h>
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -88,4 +89,4 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
   return det;
 }
 
-DECLARE_DETELEMENT(LumiSpecTracker, create_detector)
+DECLARE_PROFILED_DETELEMENT(LumiSpecTracker, create_detector)
@@ -8,6 +8,7 @@
 #include "DDRec/Surface.h"
 #include "XML/Layering.h"
 #include <XML/Helper.h>
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -47,4 +48,4 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector /
   return det;
 }
 
-DECLARE_DETELEMENT(LumiWindow, create_detector)
+DECLARE_PROFILED_DETELEMENT(LumiWindow, create_detector)
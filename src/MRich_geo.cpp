@@ -16,6 +16,7 @@
 #include "TMath.h"
 #include "TString.h"
 #include <XML/Helper.h>
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -472,4 +473,4 @@ static Ref_t createDetector(Detector& description, xml::Handle_t e, SensitiveDet
 // }
 
 // clang-format off
-DECLARE_DETELEMENT(epic_MRICH, createDetector)
+DECLARE_PROFILED_DETELEMENT(epic_MRICH, createDetector)
@@ -0,0 +1,249 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 ePIC Collaboration
+
+//==========================================================================
+//  Material scan
+//
+//  Traces straight rays from a start point through the closed geometry
+//  over an (eta, phi) grid of directions, with one TGeoNavigator per
+//  thread, and writes the path length, radiation lengths and nuclear
+//  interaction lengths crossed per ray, top-level detector and material
+//  as csv. Directions follow bin/g4MaterialScan_to_csv, which remains the
+//  Geant4 reference: (cos(phi), sin(phi), sinh(eta)), phi in degrees.
+//--------------------------------------------------------------------------
+
+#include <DD4hep/DetFactoryHelper.h>
+#include <DD4hep/Factories.h>
+#include <DD4hep/Printout.h>
+
+#include <TGeoManager.h>
+#include <TGeoMaterial.h>
+#include <TGeoNavigator.h>
+#include <TGeoNode.h>
+#include <TList.h>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace dd4hep;
+
+namespace {
+
+// <min>[:<max>[:<step>]], the maximum included
+std::vector<double> parse_range(const char* arg) {
+  double min = 0., max = 0., step = 1.;
+  const int n = std::sscanf(arg, "%lf:%lf:%lf", &min, &max, &step);
+  if (n < 1 || (n > 1 && (step <= 0. || max < min))) {
+    return {};
+  }
+  if (n == 1) {
+    return {min};
+  }
+  std::vector<double> values;
+  const long count = std::lround(std::floor((max - min) / step + 1e-6)) + 1;
+  for (long i = 0; i < count; ++i) {
+    values.push_back(min + i * step);
+  }
+  return values;
+}
+
+// material crossed by one ray in one top-level detector
+struct Crossing {
+  int detector;
+  int material;
+  double path_length;
+  double x0;
+  double lambda;
+};
+
+} // namespace
+
+static void usage_material_scan(int argc, char** argv) {
+  std::cerr
+      << "Usage: -plugin <name> -arg [-arg]                                                  \n"
+         "     output:<string>          csv output (default material_scan.csv)               \n"
+         "     eta:<min>[:<max>[:<step>]]   pseudorapidities (default -4:4:0.1)              \n"
+         "     phi:<min>[:<max>[:<step>]]   azimuthal angles in degrees (default 0:30:1)     \n"
+         "     start:<x>,<y>,<z>        start point in cm (default 0,0,0)                    \n"
+         "     threads:<int>            number of threads (default: all cores)               \n"
+         "\tArguments given: "
+      << arguments(argc, argv) << std::endl;
+  std::exit(EINVAL);
+}
+
+// Plugin to scan the material budget per detector and material over a direction grid
+static long material_scan(Detector& desc, int argc, char** argv) {
+  std::string output       = "material_scan.csv";
+  std::vector<double> etas = parse_range("-4:4:0.1");
+  std::vector<double> phis = parse_range("0:30:1");
+  double start[3]          = {0., 0., 0.};
+  unsigned n_threads       = std::max(1u, std::thread::hardware_concurrency());
+  for (int i = 0; i < argc && argv[i]; ++i) {
+    if (0 == std::strncmp("output:", argv[i], 7))
+      output = (argv[i] + 7);
+    else if (0 == std::strncmp("eta:", argv[i], 4))
+      etas = parse_range(argv[i] + 4);
+    else if (0 == std::strncmp("phi:", argv[i], 4))
+      phis = parse_range(argv[i] + 4);
+    else if (0 == std::strncmp("start:", argv[i], 6)) {
+      if (std::sscanf(argv[i] + 6, "%lf,%lf,%lf", &start[0], &start[1], &start[2]) != 3)
+        usage_material_scan(argc, argv);
+    } else if (0 == std::strncmp("threads:", argv[i], 8))
+      n_threads = std::max(1, std::atoi(argv[i] + 8));
+    else {
+      std::cerr << "Unexpected argument \"" << argv[i] << "\"" << std::endl;
+      usage_material_scan(argc, argv);
+    }
+  }
+  if (etas.empty() || phis.empty()) {
+    usage_material_scan(argc, argv);
+  }
+
+  TGeoManager& mgr = desc.manager();
+
+  // index the top-level detectors by their placement in the world, 0 for the world itself
+  std::vector<std::string> detectors{"world"};
+  std::unordered_map<const TGeoNode*, int> detector_index;
+  for (const auto& [name, det] : desc.world().children()) {
+    if (det.placement().isValid()) {
+      detector_index[det.placement().ptr()] = detectors.size();
+      detectors.push_back(name);
+    }
+  }
+  // world daughters without a DetElement (e.g. assemblies of supports) keep their node name
+  TGeoVolume* world_vol = mgr.GetTopVolume();
+  for (int i = 0; i < world_vol->GetNdaughters(); ++i) {
+    if (detector_index.try_emplace(world_vol->GetNode(i), detectors.size()).second) {
+      detectors.push_back(world_vol->GetNode(i)->GetName());
+    }
+  }
+  std::vector<std::string> materials;
+  std::unordered_map<const TGeoMaterial*, int> material_index;
+  for (TObject* obj : *mgr.GetListOfMaterials()) {
+    material_index[static_cast<TGeoMaterial*>(obj)] = materials.size();
+    materials.push_back(obj->GetName());
+  }
+
+  // guard against rays stuck on a boundary
+  constexpr long kMaxSteps = 100000;
+
+  // crossings per ray, in (eta, phi) order whatever the number of threads
+  const size_t n_rays = etas.size() * phis.size();
+  std::vector<std::vector<Crossing>> crossings(n_rays);
+  std::atomic<size_t> next{0};
+  std::atomic<long> steps{0};
+  std::atomic<long> stuck{0};
+  auto worker = [&]() {
+    TGeoNavigator* nav = mgr.GetCurrentNavigator();
+    const bool own_nav = (nav == nullptr);
+    if (own_nav) {
+      nav = mgr.AddNavigator();
+    }
+    long thread_steps = 0;
+    for (size_t ray = next++; ray < n_rays; ray = next++) {
+      const double eta    = etas[ray / phis.size()];
+      const double phi    = phis[ray % phis.size()] * M_PI / 180.;
+      const double norm   = std::cosh(eta);
+      const double dir[3] = {std::cos(phi) / norm, std::sin(phi) / norm, std::tanh(eta)};
+      nav->InitTrack(start, dir);
+      auto& ray_crossings = crossings[ray];
+      long ray_steps      = 0;
+      while (!nav->IsOutside() && ray_steps < kMaxSteps) {
+        const int level = nav->GetLevel();
+        int det         = 0;
+        if (level > 0) {
+          auto it = detector_index.find(nav->GetMother(level - 1));
+          det     = it != detector_index.end() ? it->second : 0;
+        }
+        TGeoMaterial* mat = nav->GetCurrentVolume()->GetMaterial();
+        nav->FindNextBoundaryAndStep();
+        ++ray_steps;
+        const double step = nav->GetStep();
+        if (step <= 0.) {
+          continue;
+        }
+        const int mat_idx = material_index.at(mat);
+        auto it           = std::find_if(
+            ray_crossings.begin(), ray_crossings.end(),
+            [&](const Crossing& c) { return c.detector == det && c.material == mat_idx; });
+        if (it == ray_crossings.end()) {
+          it = ray_crossings.insert(it, {det, mat_idx, 0., 0., 0.});
+        }
+        it->path_length += step;
+        it->x0 += step / mat->GetRadLen();
+        it->lambda += step / mat->GetIntLen();
+      }
+      if (ray_steps == kMaxSteps) {
+        ++stuck;
+      }
+      thread_steps += ray_steps;
+    }
+    steps += thread_steps;
+    if (own_nav) {
+      mgr.RemoveNavigator(nav);
+    }
+  };
+
+  // TGeo needs its thread data for more than one navigator, which requires a closed geometry
+  if (n_threads > 1 && !mgr.IsClosed()) {
+    printout(WARNING, "MaterialScan", "geometry is not closed, scanning on a single thread");
+    n_threads = 1;
+  }
+  n_threads = std::min<size_t>(n_threads, n_rays);
+  if (n_threads > 1) {
+    mgr.SetMaxThreads(n_threads);
+  }
+
+  auto t_start = std::chrono::steady_clock::now();
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < n_threads; ++t) {
+    pool.emplace_back(worker);
+  }
+  worker();
+  for (auto& th : pool) {
+    th.join();
+  }
+  auto t_end = std::chrono::steady_clock::now();
+
+  const double seconds = std::chrono::duration<double>(t_end - t_start).count();
+  printout(INFO, "MaterialScan",
+           "%zu rays (%zu eta x %zu phi) on %u threads: %.3f s, %.0f rays/s, %.1f steps/ray",
+           n_rays, etas.size(), phis.size(), n_threads, seconds, n_rays / seconds,
+           double(steps) / n_rays);
+  if (stuck > 0) {
+    printout(WARNING, "MaterialScan", "%ld rays stopped after %ld steps", long(stuck), kMaxSteps);
+  }
+
+  // one row per ray, detector and material, path length in cm
+  std::ofstream out(output);
+  if (!out) {
+    printout(ERROR, "MaterialScan", "unable to write " + output);
+    return 0;
+  }
+  out << "eta,phi,detector,material,path_length,X0,lambda\n";
+  for (size_t ray = 0; ray < n_rays; ++ray) {
+    const double eta = etas[ray / phis.size()];
+    const double phi = phis[ray % phis.size()];
+    for (const auto& c : crossings[ray]) {
+      out << fmt::format("{:g},{:g},{},{},{:g},{:g},{:g}\n", eta, phi, detectors[c.detector],
+                         materials[c.material], c.path_length / dd4hep::cm, c.x0, c.lambda);
+    }
+  }
+  printout(INFO, "MaterialScan", "scan written to " + output);
+  return 1;
+}
+
+DECLARE_APPLY(epic_MaterialScan, material_scan)
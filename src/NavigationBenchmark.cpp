@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 ePIC Collaboration
+
+//==========================================================================
+//  Navigation benchmark
+//
+//  Shoots straight tracks from the origin through the closed geometry with
+//  a TGeoNavigator, and reports the boundary crossings and wall-clock time
+//  per track. Compare runs of the same seed to judge how shape choices
+//  (e.g. tessellated vs. extruded steel) affect navigation cost.
+//--------------------------------------------------------------------------
+
+#include <DD4hep/DetFactoryHelper.h>
+#include <DD4hep/Factories.h>
+#include <DD4hep/Printout.h>
+
+#include <TGeoManager.h>
+#include <TGeoNavigator.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace dd4hep;
+
+static void usage_navigation_benchmark(int argc, char** argv) {
+  std::cerr
+      << "Usage: -plugin <name> -arg [-arg]                                                  \n"
+         "     tracks:<int>             number of tracks (default 10000)                     \n"
+         "     seed:<int>               random seed (default 1)                              \n"
+         "     etamin:<double>          minimum pseudorapidity (default -1.2)                \n"
+         "     etamax:<double>          maximum pseudorapidity (default 1.2)                 \n"
+         "\tArguments given: "
+      << arguments(argc, argv) << std::endl;
+  std::exit(EINVAL);
+}
+
+// Plugin to time straight-track navigation through the geometry
+static long navigation_benchmark(Detector& desc, int argc, char** argv) {
+  long tracks   = 10000;
+  long seed     = 1;
+  double etamin = -1.2;
+  double etamax = 1.2;
+  for (int i = 0; i < argc && argv[i]; ++i) {
+    if (0 == std::strncmp("tracks:", argv[i], 7))
+      tracks = std::atol(argv[i] + 7);
+    else if (0 == std::strncmp("seed:", argv[i], 5))
+      seed = std::atol(argv[i] + 5);
+    else if (0 == std::strncmp("etamin:", argv[i], 7))
+      etamin = std::atof(argv[i] + 7);
+    else if (0 == std::strncmp("etamax:", argv[i], 7))
+      etamax = std::atof(argv[i] + 7);
+    else {
+      std::cerr << "Unexpected argument \"" << argv[i] << "\"" << std::endl;
+      usage_navigation_benchmark(argc, argv);
+    }
+  }
+  if (tracks <= 0 || etamax < etamin) {
+    usage_navigation_benchmark(argc, argv);
+  }
+
+  TGeoManager& mgr   = desc.manager();
+  TGeoNavigator* nav = mgr.GetCurrentNavigator();
+  if (nav == nullptr) {
+    nav = mgr.AddNavigator();
+  }
+
+  std::mt19937_64 rng(seed);
+  std::uniform_real_distribution<double> eta_dist(etamin, etamax);
+  std::uniform_real_distribution<double> phi_dist(-M_PI, M_PI);
+
+  // guard against tracks stuck on a boundary
+  constexpr long kMaxSteps = 100000;
+
+  long steps   = 0;
+  long stuck   = 0;
+  auto t_start = std::chrono::steady_clock::now();
+  for (long n = 0; n < tracks; ++n) {
+    const double theta  = 2.0 * std::atan(std::exp(-eta_dist(rng)));
+    const double phi    = phi_dist(rng);
+    const double pos[3] = {0.0, 0.0, 0.0};
+    const double dir[3] = {std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi),
+                           std::cos(theta)};
+    nav->InitTrack(pos, dir);
+    long track_steps = 0;
+    while (!nav->IsOutside() && track_steps < kMaxSteps) {
+      nav->FindNextBoundaryAndStep();
+      ++track_steps;
+    }
+    if (track_steps == kMaxSteps) {
+      ++stuck;
+    }
+    steps += track_steps;
+  }
+  auto t_end = std::chrono::steady_clock::now();
+
+  const double seconds = std::chrono::duration<double>(t_end - t_start).count();
+  printout(INFO, "NavigationBenchmark", "%ld tracks in eta [%g, %g]: %.3f s, %.2f us/track",
+           tracks, etamin, etamax, seconds, 1e6 * seconds / tracks);
+  printout(INFO, "NavigationBenchmark", "%ld steps, %.1f steps/track, %.3f us/step", steps,
+           double(steps) / tracks, 1e6 * seconds / std::max(steps, 1L));
+  if (stuck > 0) {
+    printout(WARNING, "NavigationBenchmark", "%ld tracks stopped after %ld steps", stuck,
+             kMaxSteps);
+  }
+  return 1;
+}
+
+DECLARE_APPLY(epic_NavigationBenchmark, navigation_benchmark)
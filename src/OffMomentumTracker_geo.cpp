@@ -5,6 +5,8 @@
 #include "XML/Layering.h"
 #include "XML/Utilities.h"
 #include <map>
+#include "ConstructionProfiler.h"
+#include "TrackerModuleBuilder.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -18,7 +20,6 @@ using namespace dd4hep::detail;
  * @author Whitney Armstrong
  */
 static Ref_t create_OffMomentumTracker(Detector& description, xml_h e, SensitiveDetector sens) {
-  typedef vector<PlacedVolume> Placements;
   xml_det_t x_det = e;
   Material vacuum = description.vacuum();
   int det_id      = x_det.id();
@@ -32,8 +33,7 @@ static Ref_t create_OffMomentumTracker(Detector& description, xml_h e, Sensitive
   //  Volume      assembly    (det_name,Box(10000,10000,10000),vacuum);
   Volume motherVol = description.pickMotherVolume(sdet);
   int m_id = 0, c_id = 0, n_sensor = 0;
-  map<string, Volume> modules;
-  map<string, Placements> sensitives;
+  map<string, epic::tracker::ModuleType> module_types;
   PlacedVolume pv;
 
   assembly.setVisAttributes(description.invisible());
@@ -86,12 +86,9 @@ static Ref_t create_OffMomentumTracker(Detector& description, xml_h e, Sensitive
     double x1 = x_box.x();
     double y1 = x_box.y();
     // double     z1              = x_box.z();
-    double total_thickness = 0.;
-
-    xml_coll_t ci(x_mod, _U(module_component));
-    for (ci.reset(), total_thickness = 0.0; ci; ++ci) {
-      total_thickness += xml_comp_t(ci).thickness();
-    }
+    epic::tracker::ModuleStack stack    = epic::tracker::stackComponents(x_mod);
+    double total_thickness              = stack.total_thickness;
+    epic::tracker::ModuleType& mod_type = module_types[m_nam];
 
     Box m_solid(x1 / 2.0, y1 / 2.0, total_thickness / 2.0);
     Volume m_volume(m_nam, m_solid, vacuum);
@@ -122,9 +119,10 @@ static Ref_t create_OffMomentumTracker(Detector& description, xml_h e, Sensitive
       // pv = m_volume.placeVolume(f_vol, Position(f_pos.x(), f_pos.y(),  f_pos.z()));
     }
 
-    double posZ = -total_thickness / 2.0;
-    for (ci.reset(), n_sensor = 1, c_id = 0, posZ = -total_thickness / 2.0; ci; ++ci, ++c_id) {
-      xml_comp_t c   = ci;
+    n_sensor = 1;
+    c_id     = 0;
+    for (auto& comp : stack.components) {
+      xml_comp_t c   = comp.x_comp;
       double c_thick = c.thickness();
       auto comp_x    = getAttrOrDefault(c, _Unicode(x), x1);
       auto comp_y    = getAttrOrDefault(c, _Unicode(y), y1);
@@ -140,7 +138,7 @@ static Ref_t create_OffMomentumTracker(Detector& description, xml_h e, Sensitive
       Volume c_vol(c_name, comp_shape, c_mat);
 
       c_vol.setVisAttributes(description.visAttributes(c.visStr()));
-      pv = m_volume.placeVolume(c_vol, Position(0, 0, posZ + c_thick / 2.0));
+      pv = m_volume.placeVolume(c_vol, Position(0, 0, comp.center));
       if (c.isSensitive()) {
         // std::cout << " adding sensitive volume" << c_name << "\n";
         sdet.check(n_sensor > 2,
@@ -148,12 +146,12 @@ static Ref_t create_OffMomentumTracker(Detector& description, xml_h e, Sensitive
         pv.addPhysVolID("slice", n_sensor);
         sens.setType("tracker");
         c_vol.setSensitiveDetector(sens);
-        sensitives[m_nam].push_back(pv);
+        mod_type.sensors.push_back(pv);
         ++n_sensor;
       }
-      posZ += c_thick;
+      ++c_id;
     }
-    modules[m_nam] = m_volume;
+    mod_type.volume = m_volume;
   }
 
   for (xml_coll_t li(x_det, _U(layer)); li; ++li) {
@@ -194,19 +192,13 @@ static Ref_t create_OffMomentumTracker(Detector& description, xml_h e, Sensitive
     DetElement layer_element(sdet, layer_name, l_id);
     layer_element.setPlacement(layer_pv);
 
-    string m_nam         = x_layer.moduleStr();
-    Volume m_vol         = modules[m_nam];
-    Placements& sensVols = sensitives[m_nam];
+    const epic::tracker::ModuleType& mod_type = module_types[x_layer.moduleStr()];
 
     DetElement module(layer_element, "module_", l_id);
-    pv = layer_vol.placeVolume(m_vol, Position(0, 0, 0));
+    pv = layer_vol.placeVolume(mod_type.volume, Position(0, 0, 0));
     pv.addPhysVolID("layer", l_id).addPhysVolID("module", mod_num);
     module.setPlacement(pv);
-    for (size_t ic = 0; ic < sensVols.size(); ++ic) {
-      PlacedVolume sens_pv = sensVols[ic];
-      DetElement comp_elt(module, sens_pv.volume().name(), mod_num);
-      comp_elt.setPlacement(sens_pv);
-    }
+    epic::tracker::addSensorElements(module, mod_type, "", mod_num);
 
     // for (xml_coll_t ri(x_layer, _U(ring)); ri; ++ri) {
     //  xml_comp_t  x_ring   = ri;
@@ -272,4 +264,4 @@ static Ref_t create_OffMomentumTracker(Detector& description, xml_h e, Sensitive
 }
 
 // clang-format off
-DECLARE_DETELEMENT(ip6_OffMomentumTracker, create_OffMomentumTracker)
+DECLARE_PROFILED_DETELEMENT(ip6_OffMomentumTracker, create_OffMomentumTracker)
@@ -24,11 +24,91 @@
 #include "TInterpreter.h"
 #include "TUri.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "ConstructionProfiler.h"
+
 using namespace std;
 using namespace dd4hep;
 using namespace dd4hep::rec;
 using namespace dd4hep::detail;
 
+namespace {
+
+// true if `phi` lies within the azimuthal range [start, start + width]
+bool inPhiRange(double phi, double start, double width) {
+  return std::fmod(std::fmod(phi - start, 2 * M_PI) + 2 * M_PI, 2 * M_PI) <= width;
+}
+
+// xy-footprint of the beam pipe flange: two discs, and the convex polygon bridging them
+struct FlangeFootprint {
+  struct Disc {
+    double x, y, r;
+  };
+  std::vector<Disc> discs;
+  std::vector<std::pair<double, double>> polygon;
+
+  // distance from (x, y) to the annular sector [r0, r1] x [phi0, phi0 + dphi]
+  static double sectorDistance(double x, double y, double r0, double r1, double phi0,
+                               double dphi) {
+    double rc = std::hypot(x, y);
+    if (rc == 0)
+      return r0;
+    if (inPhiRange(std::atan2(y, x), phi0, dphi))
+      return rc < r0 ? r0 - rc : (rc > r1 ? rc - r1 : 0);
+    // otherwise, the closest point is on one of the radial edges
+    auto edgeDistance = [&](double phi) {
+      double ux = std::cos(phi), uy = std::sin(phi);
+      double t  = std::clamp(x * ux + y * uy, r0, r1);
+      return std::hypot(x - t * ux, y - t * uy);
+    };
+    return std::min(edgeDistance(phi0), edgeDistance(phi0 + dphi));
+  }
+
+  // conservative test whether the annular sector [r0, r1] x [phi0, phi0 + dphi] overlaps
+  // the footprint; sectors for which this is false are not touched by the flange
+  bool overlaps(double r0, double r1, double phi0, double dphi) const {
+    for (const auto& disc : discs)
+      if (sectorDistance(disc.x, disc.y, r0, r1, phi0, dphi) < disc.r)
+        return true;
+    // azimuthal extent of the polygon outside of r0: its vertices outside of r0, and the
+    // crossings of its edges with r0
+    std::vector<std::pair<double, double>> points;
+    for (std::size_t i = 0; i < polygon.size(); i++) {
+      auto [ax, ay] = polygon[i];
+      auto [bx, by] = polygon[(i + 1) % polygon.size()];
+      if (std::hypot(ax, ay) >= r0)
+        points.emplace_back(ax, ay);
+      double dx = bx - ax, dy = by - ay;
+      double qa = dx * dx + dy * dy, qb = 2 * (ax * dx + ay * dy), qc = ax * ax + ay * ay - r0 * r0;
+      double dq = qb * qb - 4 * qa * qc;
+      if (dq < 0)
+        continue;
+      for (double t : {(-qb - std::sqrt(dq)) / (2 * qa), (-qb + std::sqrt(dq)) / (2 * qa)})
+        if (t >= 0 && t <= 1)
+          points.emplace_back(ax + t * dx, ay + t * dy);
+    }
+    if (points.empty())
+      return false;
+    double sx = 0, sy = 0;
+    for (auto [px, py] : points) {
+      sx += px;
+      sy += py;
+    }
+    double ref = std::atan2(sy, sx), lo = 0, hi = 0;
+    for (auto [px, py] : points) {
+      double d = std::remainder(std::atan2(py, px) - ref, 2 * M_PI);
+      lo       = std::min(lo, d);
+      hi       = std::max(hi, d);
+    }
+    return inPhiRange(ref + lo, phi0, dphi) || inPhiRange(phi0, ref + lo, hi - lo);
+  }
+};
+
+} // namespace
+
 static Ref_t createDetector(Detector& description, xml_h e, SensitiveDetector sens) {
 
   xml_det_t x_det = e;
@@ -184,6 +264,11 @@ static Ref_t createDetector(Detector& description, xml_h e, SensitiveDetector se
   Transform3D transform_flange(rZ, Position(-b - pDy1, 0.0, 0.0));
   UnionSolid flange_final_shape(flange_shape, wedge, transform_flange);
 
+  // xy-footprint of `flange_final_shape`, to subtract it only from the tiles it overlaps
+  FlangeFootprint flangeFootprint{
+      {{0.0, 0.0, r0}, {-_FLANGE_HPIPE_OFFSET_, 0.0, r1}},
+      {{-b, -pDx1}, {-b, pDx1}, {-b - 2 * pDy1, pDx2}, {-b - 2 * pDy1, -pDx2}}};
+
   Volume flangeVol(detName + "_flange", flange_final_shape, mirrorMat);
   flangeVol.setVisAttributes(mirrorVis);
 
@@ -591,7 +676,9 @@ static Ref_t createDetector(Detector& description, xml_h e, SensitiveDetector se
 
         Tube agtube_inner(aerogel_r0, aerogel_r1, agthick / 2, 0 * degree + ia * apitch,
                           wd0 + ia * apitch);
-        SubtractionSolid agsub(agtube_inner, flange_final_shape);
+        Solid agsub = agtube_inner;
+        if (flangeFootprint.overlaps(aerogel_r0, aerogel_r1, ia * apitch, wd0))
+          agsub = SubtractionSolid(agtube_inner, flange_final_shape);
         Volume agsubtubeVol(ag_name.Data(), agsub, gasvolMat);
         auto aerogelTilePlacement =
             Transform3D(RotationZYX(0.0, 0.0, 0.0), Position(0.0, 0.0, -m_gzOffset));
@@ -604,7 +691,9 @@ static Ref_t createDetector(Detector& description, xml_h e, SensitiveDetector se
         Tube sptube_inner(aerogel_r0, aerogel_r1, agthick / 2, wd0 + ia * apitch,
                           wd0 + wd1 + ia * apitch);
 
-        SubtractionSolid spsub(sptube_inner, flange_final_shape);
+        Solid spsub = sptube_inner;
+        if (flangeFootprint.overlaps(aerogel_r0, aerogel_r1, wd0 + ia * apitch, wd1))
+          spsub = SubtractionSolid(sptube_inner, flange_final_shape);
         Volume spsubtubeVol(sp_name.Data(), spsub, mirrorMat);
         auto spTilePlacement =
             Transform3D(RotationZYX(0.0, 0.0, 0.0), Position(0.0, 0.0, -m_gzOffset));
@@ -654,7 +743,9 @@ static Ref_t createDetector(Detector& description, xml_h e, SensitiveDetector se
 
     else {
 
-      SubtractionSolid spsub(sptube, flange_final_shape);
+      Solid spsub = sptube;
+      if (flangeFootprint.overlaps(sp_r0, sp_r1, 0, 2 * M_PI))
+        spsub = SubtractionSolid(sptube, flange_final_shape);
       Volume agsubtubeVol(detName + "_radial_sptube_inner", spsub, gasvolMat);
 
       auto sptubePV = pfRICH_volume.placeVolume(agsubtubeVol, sptubePlacement);
@@ -731,4 +822,4 @@ static Ref_t createDetector(Detector& description, xml_h e, SensitiveDetector se
 }
 
 // clang-format off
-DECLARE_DETELEMENT(epic_PFRICH, createDetector)
+DECLARE_PROFILED_DETELEMENT(epic_PFRICH, createDetector)
@@ -19,6 +19,8 @@
 //==========================================================================
 #include "DD4hep/DetFactoryHelper.h"
 #include "XML/Layering.h"
+#include "ConstructionProfiler.h"
+#include "LayeredCalorimeterBuilder.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -52,6 +54,7 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
 
   endcapVol.setAttributes(description, x_det.regionStr(), x_det.limitsStr(), x_det.visStr());
 
+  epic::calorimeter::BudgetSummary budgets;
   for (xml_coll_t xc(x_det, _U(layer)); xc; ++xc) {
     // std::cout << "l_num = " << l_num << "\n";
     // std::cout << "xc = " << xc << "\n";
@@ -60,46 +63,32 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
     // std::cout << "xc = " << xc << "\n";
     string l_name = _toString(layerType, "layer%d");
     int l_repeat  = x_layer.repeat();
-    Volume l_vol(l_name, PolyhedraRegular(numsides, rmin, rmax, l_thick), air);
-    vector<PlacedVolume> sensitives;
-
-    int s_num     = 1;
-    double sliceZ = -l_thick / 2;
-    for (xml_coll_t xs(x_layer, _U(slice)); xs; ++xs) {
-      xml_comp_t x_slice = xs;
-      string s_name      = _toString(s_num, "slice%d");
-      double s_thick     = x_slice.thickness();
-      Material s_mat     = description.material(x_slice.materialStr());
-      Volume s_vol(s_name, PolyhedraRegular(numsides, rmin, rmax, s_thick), s_mat);
-
-      s_vol.setVisAttributes(description.visAttributes(x_slice.visStr()));
-      sliceZ += s_thick / 2;
-      PlacedVolume s_phv = l_vol.placeVolume(s_vol, Position(0, 0, sliceZ));
-      s_phv.addPhysVolID("slice", s_num);
-      if (x_slice.isSensitive()) {
-        sens.setType("calorimeter");
-        s_vol.setSensitiveDetector(sens);
-        sensitives.push_back(s_phv);
-      }
-      sliceZ += s_thick / 2;
-      s_num++;
-    }
-    l_vol.setVisAttributes(description.visAttributes(x_layer.visStr()));
     if (l_repeat <= 0)
       throw std::runtime_error(x_det.nameStr() + "> Invalid repeat value");
-    for (int j = 0; j < l_repeat; ++j) {
-      string phys_lay = _toString(l_num, "layer%d");
-      layerZ += l_thick / 2;
-      DetElement layer_elt(endcap, phys_lay, l_num);
-      PlacedVolume pv = endcapVol.placeVolume(l_vol, Position(0, 0, layerZ));
-      pv.addPhysVolID("layer", l_num);
+
+    // build the layer once, and place it l_repeat times
+    epic::calorimeter::LayerType layer;
+    layer.volume = Volume(l_name, PolyhedraRegular(numsides, rmin, rmax, l_thick), air);
+    epic::calorimeter::buildSlices(description, layer, x_layer, l_thick, sens, "",
+                                   [&](double s_thick) -> Solid {
+                                     return PolyhedraRegular(numsides, rmin, rmax, s_thick);
+                                   });
+    layer.volume.setVisAttributes(description.visAttributes(x_layer.visStr()));
+    layer.budget.name   = l_name;
+    layer.budget.repeat = l_repeat;
+    budgets.add(layer.budget);
+
+    auto placements = epic::calorimeter::placeLayers(endcapVol, layer, l_repeat,
+                                                     layerZ + l_thick / 2, l_thick, l_num);
+    for (auto& pv : placements) {
+      DetElement layer_elt(endcap, _toString(l_num, "layer%d"), l_num);
       layer_elt.setPlacement(pv);
-      for (size_t ic = 0; ic < sensitives.size(); ++ic) {
-        PlacedVolume sens_pv = sensitives[ic];
+      for (size_t ic = 0; ic < layer.sensitives.size(); ++ic) {
+        PlacedVolume sens_pv = layer.sensitives[ic];
         DetElement comp_elt(layer_elt, sens_pv.volume().name(), l_num);
         comp_elt.setPlacement(sens_pv);
       }
-      layerZ += l_thick / 2;
+      layerZ += l_thick;
       ++l_num;
     }
     ++layerType;
@@ -128,9 +117,10 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
   pv = motherVol.placeVolume(assembly, Position(pos.x(), pos.y(), pos.z()));
   pv.addPhysVolID("system", det_id);
   endcapAssyDE.setPlacement(pv);
+  budgets.report(endcapAssyDE, "PolyhedraEndcapCalorimeter2");
   return endcapAssyDE;
 }
 
 // clang-format off
-DECLARE_DETELEMENT(epic_PolyhedraEndcapCalorimeter2, create_detector)
-DECLARE_DETELEMENT(epic_PolyhedraEndcapCalorimeter, create_detector)
+DECLARE_PROFILED_DETELEMENT(epic_PolyhedraEndcapCalorimeter2, create_detector)
+DECLARE_PROFILED_DETELEMENT(epic_PolyhedraEndcapCalorimeter, create_detector)
@@ -11,18 +11,25 @@
 //==========================================================================
 
 #include "DD4hep/DetFactoryHelper.h"
+#include "DD4hep/Printout.h"
 #include "GeometryHelpers.h"
 #include <XML/Helper.h>
 #include <algorithm>
 #include <iostream>
 #include <math.h>
+#include <stdexcept>
 #include <tuple>
+#include "ConstructionProfiler.h"
+#include "FiberLatticeSegmentation.h"
+#include "SliceMixture.h"
 
 using namespace dd4hep;
 using Point = ROOT::Math::XYPoint;
 
-std::tuple<Volume, Position> build_module(const Detector& desc, const xml::Component& mod_x,
-                                          SensitiveDetector& sens);
+// module volume, size and, for homogenized modules, the scintillator mass fraction
+std::tuple<Volume, Position, double> build_module(const Detector& desc,
+                                                  const xml::Component& mod_x,
+                                                  SensitiveDetector& sens, bool homogenized);
 
 // helper function to get x, y, z if defined in a xml component
 template <class XmlComp> Position get_xml_xyz(const XmlComp& comp, dd4hep::xml::Strng_t name) {
@@ -43,6 +50,11 @@ static Ref_t create_detector(Detector& desc, xml::Handle_t handle, SensitiveDete
   int detID               = detElem.id();
   DetElement det(detName, detID);
   sens.setType("calorimeter");
+
+  // full: individual fibers; homogenized: the module is one sensitive volume of the absorber +
+  // fiber mixture, with virtual fibers from the FiberLattice segmentation
+  bool homogenized = epic::calorimeter::homogenizedMode(detElem, "ScFiCalorimeter");
+
   auto dim    = detElem.dimensions();
   auto rmin   = dim.rmin();
   auto rmax   = dim.rmax();
@@ -55,7 +67,15 @@ static Ref_t create_detector(Detector& desc, xml::Handle_t handle, SensitiveDete
   env.setVisAttributes(desc.visAttributes(detElem.visStr()));
 
   // build module
-  auto [modVol, modSize] = build_module(desc, detElem.child(_Unicode(module)), sens);
+  auto [modVol, modSize, scintFraction] =
+      build_module(desc, detElem.child(_Unicode(module)), sens, homogenized);
+  if (homogenized) {
+    // the hits include the absorber deposits, this is a starting point for the sampling
+    // fraction calibration
+    desc.add(Constant(detName + "_ScintillatorMassFraction", _toString(scintFraction, "%.6f")));
+    printout(INFO, "ScFiCalorimeter", "%s: homogenized, scintillator mass fraction %.4f",
+             detName.c_str(), scintFraction);
+  }
   double modSizeR        = std::sqrt(modSize.x() * modSize.x() + modSize.y() * modSize.y());
   double assembly_rwidth = modSizeR * 2.;
   int nas                = int((rmax - rmin) / assembly_rwidth) + 1;
@@ -104,8 +124,9 @@ static Ref_t create_detector(Detector& desc, xml::Handle_t handle, SensitiveDete
 }
 
 // helper function to build module with scintillating fibers
-std::tuple<Volume, Position> build_module(const Detector& desc, const xml::Component& mod_x,
-                                          SensitiveDetector& sens) {
+std::tuple<Volume, Position, double> build_module(const Detector& desc,
+                                                  const xml::Component& mod_x,
+                                                  SensitiveDetector& sens, bool homogenized) {
   auto sx = mod_x.attr<double>(_Unicode(sizex));
   auto sy = mod_x.attr<double>(_Unicode(sizey));
   auto sz = mod_x.attr<double>(_Unicode(sizez));
@@ -113,6 +134,7 @@ std::tuple<Volume, Position> build_module(const Detector& desc, const xml::Compo
   Box modShape(sx / 2., sy / 2., sz / 2.);
   auto modMat = desc.material(mod_x.attr<std::string>(_Unicode(material)));
   Volume modVol("module_vol", modShape, modMat);
+  double scintFraction = 0.;
   if (mod_x.hasAttr(_Unicode(vis))) {
     modVol.setVisAttributes(desc.visAttributes(mod_x.attr<std::string>(_Unicode(vis))));
   }
@@ -157,6 +179,17 @@ std::tuple<Volume, Position> build_module(const Detector& desc, const xml::Compo
     // place the fibers
     double y0   = (foff + fside);
     int nfibers = 0;
+    if (homogenized) {
+      // same lattice as the fibers below, in the module frame, with fiber_x/fiber_y from 1
+      auto* lattice =
+          dynamic_cast<epic::FiberLattice*>(sens.readout().segmentation().segmentation());
+      if (lattice == nullptr) {
+        printout(ERROR, "ScFiCalorimeter", "homogenized mode needs a FiberLattice readout");
+        throw std::runtime_error("ScFiCalorimeter: homogenized mode needs FiberLattice");
+      }
+      lattice->setLattice(fdistx, fdisty, -sx / 2. + foff + fside + fdistx / 2., -sy / 2. + y0,
+                          -fdistx / 2., 1);
+    }
     for (int iy = 0; iy < ny; ++iy) {
       double y = y0 + fdisty * iy;
       // about to touch the boundary
@@ -170,18 +203,30 @@ std::tuple<Volume, Position> build_module(const Detector& desc, const xml::Compo
         if ((sx - x) < x0) {
           break;
         }
+        if (homogenized) {
+          nfibers++;
+          continue;
+        }
         auto fiberPV =
             modVol.placeVolume(fiberVol, nfibers++, Position{x - sx / 2., y - sy / 2., 0});
         // std::cout << "(" << ix << ", " << iy << ", " << x - sx/2. << ", " << y - sy/2. << ", " << fr << "),\n";
         fiberPV.addPhysVolID("fiber_x", ix + 1).addPhysVolID("fiber_y", iy + 1);
       }
     }
+    if (homogenized) {
+      double fraction = nfibers * M_PI * fr * fr / (sx * sy);
+      modVol.setMaterial(epic::calorimeter::fiberMixture(desc, modMat, fiberMat, fraction));
+      double rho_f  = fiberMat->GetMaterial()->GetDensity();
+      double rho_m  = modMat->GetMaterial()->GetDensity();
+      scintFraction = fraction * rho_f / (fraction * rho_f + (1. - fraction) * rho_m);
+      modVol.setSensitiveDetector(sens);
+    }
     // if no fibers we make the module itself sensitive
   } else {
     modVol.setSensitiveDetector(sens);
   }
 
-  return std::make_tuple(modVol, Position{sx, sy, sz});
+  return std::make_tuple(modVol, Position{sx, sy, sz}, scintFraction);
 }
 
-DECLARE_DETELEMENT(epic_ScFiCalorimeter, create_detector)
+DECLARE_PROFILED_DETELEMENT(epic_ScFiCalorimeter, create_detector)
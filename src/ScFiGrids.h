@@ -0,0 +1,214 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 ePIC Collaboration
+
+#pragma once
+
+#include <Math/Point2D.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+// Fiber lattice and readout grids of the barrel ScFi calorimeter slices
+//
+// Plain geometry in the x-z plane of a slice trapezoid (no TGeo objects), so that slices can
+// be planned concurrently and the grid assignment can be tested on its own.
+namespace epic::scfi {
+
+using Point = ROOT::Math::XYPoint;
+
+// readout grid: a quadrilateral of the trapezoid division, with its vertex centroid
+struct FiberGrid {
+  int ix = 0, iy = 0;
+  std::vector<Point> points;
+  Point mean_centroid = Point(0., 0.);
+
+  // initialize with grid id and points
+  FiberGrid(int i, int j, const std::vector<Point>& pts) : ix(i), iy(j), points(pts) {
+    if (pts.empty()) {
+      return;
+    }
+
+    double mx = 0., my = 0.;
+    for (auto& p : pts) {
+      mx += p.x();
+      my += p.y();
+    }
+    mx /= static_cast<double>(pts.size());
+    my /= static_cast<double>(pts.size());
+    mean_centroid = Point(mx, my);
+  };
+};
+
+// Fill fiber lattice into trapezoid starting from position (0,0) in x-z coordinate system
+inline std::vector<Point> fiberPositions(double r, double sx, double sz, double trx, double trz,
+                                         double phi, bool shift = false, double stol = 1e-2) {
+  // r      - fiber radius
+  // sx, sz - spacing between fibers in x, z
+  // trx    - half-length of the shorter (bottom) base of the trapezoid
+  // trz    - height of the trapezoid
+  // phi    - angle between z and trapezoid arm
+  // stol   - spacing tolerance
+
+  std::vector<Point> positions;
+  int z_layers = std::floor((trz / 2 - r - stol) / sz); // number of layers that fits in half trapezoid-z
+
+  double px = 0., pz = 0.;
+  int start_line = shift ? 1 : 0;
+
+  for (int l = -z_layers; l < z_layers + 1; l++) {
+    std::vector<Point> xline;
+    pz           = l * sz;
+    double x_max = trx + (trz / 2. + pz) * std::tan(phi) - stol; // calculate max x at particular z_pos
+    (std::abs(l) % 2 == start_line) ? px = 0. : px = sx / 2;     // account for spacing/2 shift
+
+    while (px < (x_max - r)) {
+      xline.push_back(Point(px, pz));
+      if (px != 0.)
+        xline.push_back(Point(-px, pz)); // using symmetry around x=0
+      px += sx;
+    }
+
+    // Sort fiber IDs for a better organization
+    std::sort(xline.begin(), xline.end(),
+         [](const Point& p1, const Point& p2) { return p1.x() < p2.x(); });
+    positions.insert(positions.end(), xline.begin(), xline.end());
+  }
+  return positions;
+}
+
+// Determine the number of divisions for the readout grid for the fiber layers
+// Calculate dimensions of the polygonal grid
+inline std::vector<FiberGrid> gridPoints(int div_n_phi, double div_dr, double trd_x1,
+                                         double height, double phi) {
+  /*
+  // TODO: move this test to xml file
+  double SiPMsize = 13.0 * mm;
+  double grid_min = SiPMsize + 3.0 * mm;
+
+  if (dz < grid_min) {
+    dz = grid_min;
+  }
+
+  if (dx < grid_min) {
+    dx = grid_min;
+  }
+  */
+  // number of divisions
+  int nph = div_n_phi;
+  int nr  = std::floor(height / div_dr);
+  if (nr == 0) {
+    nr++;
+  }
+
+  // grid vertices
+  std::vector<FiberGrid> results;
+  double dr = height / nr;
+
+  for (int ir = 0; ir <= nr; ir++) {
+    for (int iph = 0; iph <= nph; iph++) {
+      double A_y = -height / 2. + ir * dr;
+      double B_y = -height / 2. + (ir + 1) * dr;
+
+      double botl_dr = 2 * (trd_x1 + ir * dr * std::tan(phi));
+      double topl_dr = 2 * (trd_x1 + (ir + 1) * dr * std::tan(phi));
+
+      double botl_dph_dr = botl_dr / nph;
+      double topl_dph_dr = topl_dr / nph;
+
+      double A_x = -botl_dr / 2. + iph * botl_dph_dr;
+      double B_x = -topl_dr / 2. + iph * topl_dph_dr;
+
+      double C_y = B_y;
+      double D_y = A_y;
+      double C_x = B_x + topl_dph_dr;
+      double D_x = A_x + botl_dph_dr;
+
+      auto A = Point(A_x, A_y);
+      auto B = Point(B_x, B_y);
+      auto C = Point(C_x, C_y);
+      auto D = Point(D_x, D_y);
+
+      // vertex points filled in the clock-wise direction
+      results.emplace_back(FiberGrid(iph, ir, {A, B, C, D}));
+    }
+  }
+
+  return results;
+}
+
+// Assign every fiber to the first grid (in grid order) whose polygon contains it, -1 if none
+// Grid polygons are built once, and each fiber is only tested against the grids of its
+// (row, phi division) bin, plus the neighboring bins when it lies on a bin edge
+inline std::vector<int> assignGrids(const std::vector<FiberGrid>& grids,
+                                    const std::vector<Point>& fibers, int div_n_phi,
+                                    double trd_x1, double height, double phi) {
+  // grid layout of gridPoints: (nr + 1) rows of (nph + 1) grids
+  const int nph   = div_n_phi;
+  const int nr    = static_cast<int>(grids.size()) / (nph + 1) - 1;
+  const double dr = height / nr;
+
+  // orientation of each (convex) grid polygon, from the sign of its area
+  std::vector<double> orientation(grids.size());
+  for (size_t i = 0; i < grids.size(); ++i) {
+    const auto& pts = grids[i].points;
+    double area     = 0.;
+    for (size_t j = 0; j < pts.size(); ++j) {
+      const auto& q = pts[(j + 1) % pts.size()];
+      area += pts[j].x() * q.y() - q.x() * pts[j].y();
+    }
+    orientation[i] = area < 0. ? -1. : 1.;
+  }
+  // inside or on the edges of a convex polygon, with the same tolerance as TGeoPolygon
+  auto contains = [&](int ig, const Point& p) {
+    const auto& pts = grids[ig].points;
+    for (size_t j = 0; j < pts.size(); ++j) {
+      const auto& a = pts[j];
+      const auto& b = pts[(j + 1) % pts.size()];
+      double cross  = (b.x() - a.x()) * (p.y() - a.y()) - (b.y() - a.y()) * (p.x() - a.x());
+      if (orientation[ig] * cross < -1e-10) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // bin of u in [0, n], and its neighbor when u is on the bin edge
+  auto bins = [](double u, int n) {
+    constexpr double eps = 1e-6;
+    std::vector<int> result;
+    int i = static_cast<int>(std::floor(u));
+    for (int j : {i - 1, i, i + 1}) {
+      if (j >= 0 && j <= n && u > j - eps && u < j + 1 + eps) {
+        result.push_back(j);
+      }
+    }
+    return result;
+  };
+
+  std::vector<int> result(fibers.size(), -1);
+  std::vector<int> candidates;
+  for (size_t k = 0; k < fibers.size(); ++k) {
+    const auto& pos = fibers[k];
+    // grid edges are straight lines between the division points at the row boundaries
+    double h = pos.y() + height / 2.;
+    double w = 2. * (trd_x1 + h * std::tan(phi));
+    candidates.clear();
+    for (int ir : bins(h / dr, nr)) {
+      for (int iph : bins((pos.x() + w / 2.) * nph / w, nph)) {
+        candidates.push_back(ir * (nph + 1) + iph);
+      }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    for (int ig : candidates) {
+      if (contains(ig, pos)) {
+        result[k] = ig;
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+} // namespace epic::scfi
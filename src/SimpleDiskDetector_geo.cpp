@@ -18,6 +18,7 @@
 //
 //==========================================================================
 #include "DD4hep/DetFactoryHelper.h"
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -102,5 +103,5 @@ static Ref_t SimpleDiskDetector_create_detector(Detector& description, xml_h e,
   return sdet;
 }
 
-DECLARE_DETELEMENT(epic_ref_SolenoidEndcap, SimpleDiskDetector_create_detector)
-DECLARE_DETELEMENT(epic_SolenoidEndcap, SimpleDiskDetector_create_detector)
+DECLARE_PROFILED_DETELEMENT(epic_ref_SolenoidEndcap, SimpleDiskDetector_create_detector)
+DECLARE_PROFILED_DETELEMENT(epic_SolenoidEndcap, SimpleDiskDetector_create_detector)
@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 ePIC Collaboration
+
+#pragma once
+
+#include "DD4hep/DetFactoryHelper.h"
+#include "DD4hep/Printout.h"
+
+#include <TGeoManager.h>
+#include <TGeoMaterial.h>
+#include <TGeoMedium.h>
+
+#include <map>
+#include <stdexcept>
+#include <string>
+
+// Homogenized slice stacks
+//
+// A slice stack (material and thickness of each slice, e.g. the <slice>s of a <layer>) is
+// replaced by one mixture with the mass fractions of the stack, so that a volume of the
+// mixture with the thickness of the stack has the same mass, radiation lengths and nuclear
+// interaction lengths as the stack along its thickness. TGeoMixture computes the radiation
+// and interaction lengths from the elements of the mixture.
+namespace epic::calorimeter {
+
+// thickness per material name, the slice order does not matter for the mixture
+using SliceStack = std::map<std::string, double>;
+
+// Slice stack of the <slice>s of x_layer
+inline SliceStack sliceStack(xml_comp_t x_layer) {
+  SliceStack stack;
+  for (xml_coll_t l(x_layer, _U(slice)); l; ++l) {
+    xml_comp_t x_slice = l;
+    stack[x_slice.materialStr()] += x_slice.thickness();
+  }
+  return stack;
+}
+
+// Mixture of a slice stack with the given name; a mixture with that name is reused
+inline dd4hep::Material stackMixture(const dd4hep::Detector& desc, const SliceStack& stack,
+                                     const std::string& name) {
+  TGeoManager& mgr = desc.manager();
+  if (TGeoMedium* medium = mgr.GetMedium(name.c_str())) {
+    return dd4hep::Material(medium);
+  }
+  double thick  = 0.;
+  double mass   = 0.;
+  double x0     = 0.;
+  double lambda = 0.;
+  for (const auto& [matStr, t] : stack) {
+    TGeoMaterial* mat = desc.material(matStr)->GetMaterial();
+    thick += t;
+    mass += mat->GetDensity() * t;
+    x0 += t / mat->GetRadLen();
+    lambda += t / mat->GetIntLen();
+  }
+  auto* mix = new TGeoMixture(name.c_str(), stack.size(), mass / thick);
+  for (const auto& [matStr, t] : stack) {
+    TGeoMaterial* mat = desc.material(matStr)->GetMaterial();
+    mix->AddElement(mat, mat->GetDensity() * t / mass);
+  }
+  // the stack and its mixture should agree on the budget, up to the element tables of ROOT
+  dd4hep::printout(dd4hep::DEBUG, "SliceMixture",
+                   "created mixture %s with density %g g/cm3, %.4f X0 (slices %.4f), %.4f lambda "
+                   "(slices %.4f)",
+                   name.c_str(), mass / thick, thick / mix->GetRadLen(), x0,
+                   thick / mix->GetIntLen(), lambda);
+  return dd4hep::Material(new TGeoMedium(name.c_str(), mgr.GetListOfMedia()->GetSize() + 1, mix));
+}
+
+// Mixture of a slice stack, named prefix + the stack signature (material and thickness of each
+// slice). Stacks with the same signature share one mixture.
+inline dd4hep::Material sliceStackMixture(const dd4hep::Detector& desc, const SliceStack& stack,
+                                          const std::string& prefix) {
+  std::string name = prefix;
+  for (const auto& [matStr, t] : stack) {
+    name += "_" + matStr + _toString(t / dd4hep::mm, "_%gmm");
+  }
+  return stackMixture(desc, stack, name);
+}
+
+// Mixture of a fiber matrix with the fiber material, for the given fiber volume fraction.
+// Matrices with the same fibers and fraction share one mixture.
+inline dd4hep::Material fiberMixture(const dd4hep::Detector& desc, dd4hep::Material matrix,
+                                     dd4hep::Material fiber, double fiber_fraction) {
+  std::string name = std::string("ScFi_Mix_") + matrix.name() + "_" + fiber.name() +
+                     _toString(fiber_fraction, "_%.4f");
+  SliceStack stack;
+  stack[matrix.name()] += 1. - fiber_fraction;
+  stack[fiber.name()] += fiber_fraction;
+  return stackMixture(desc, stack, name);
+}
+
+// Whether the `mode` attribute of a builder selects homogenized volumes of these mixtures
+// ("homogenized") or the full geometry ("full", the default); throws on any other mode
+inline bool homogenizedMode(const dd4hep::xml::Element& x_det, const std::string& source) {
+  std::string mode = dd4hep::getAttrOrDefault<std::string>(x_det, _Unicode(mode), "full");
+  if (mode != "homogenized" && mode != "full") {
+    dd4hep::printout(dd4hep::ERROR, source, "unknown mode \"%s\", expected full or homogenized",
+                     mode.c_str());
+    throw std::runtime_error(source + ": unknown mode " + mode);
+  }
+  return mode == "homogenized";
+}
+
+} // namespace epic::calorimeter
@@ -18,6 +18,7 @@
 //
 //==========================================================================
 #include "DD4hep/DetFactoryHelper.h"
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -92,4 +93,4 @@ static Ref_t create_detector(Detector& description, xml_h e,
   return sdet;
 }
 
-DECLARE_DETELEMENT(epic_Solenoid, create_detector)
+DECLARE_PROFILED_DETELEMENT(epic_Solenoid, create_detector)
@@ -16,6 +16,7 @@
 #include <XML/Utilities.h>
 
 #include <cassert>
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -193,4 +194,4 @@ static Ref_t create_SupportServiceMaterial(Detector& description, xml_h e,
 }
 
 // clang-format off
-DECLARE_DETELEMENT(epic_SupportServiceMaterial, create_SupportServiceMaterial)
+DECLARE_PROFILED_DETELEMENT(epic_SupportServiceMaterial, create_SupportServiceMaterial)
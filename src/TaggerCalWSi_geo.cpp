@@ -7,6 +7,7 @@
 #include "DDRec/DetectorData.h"
 #include "DDRec/Surface.h"
 #include <XML/Helper.h>
+#include "ConstructionProfiler.h"
 
 //////////////////////////////////////////////////
 // Low Q2 Tagger
@@ -79,4 +80,4 @@ static Ref_t createDetector(Detector& desc, xml_h e, SensitiveDetector sens) {
   return det;
 }
 
-DECLARE_DETELEMENT(TaggerCalWSi, createDetector)
+DECLARE_PROFILED_DETELEMENT(TaggerCalWSi, createDetector)
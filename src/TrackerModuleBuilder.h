@@ -0,0 +1,227 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 ePIC Collaboration
+
+#pragma once
+
+#include "DD4hep/DetFactoryHelper.h"
+#include "DD4hepDetectorHelper.h"
+
+#include <cmath>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Shared core of the silicon tracker builders
+//
+// - stackComponents() stacks the module components along the module thickness, and keeps the
+//   material on either side of each component for the tracking surfaces.
+// - The layout policies (StaveLayout, RingLayout, ArrayLayout) turn the layout of a layer into
+//   a placement plan, the transforms of its modules in placement order.
+// - PlacementCache<Layout> computes every distinct plan once per detector.
+// - ModuleType holds the sensor placements (and surfaces) of a module type, which every placed
+//   module shares through addSensorElements().
+namespace epic::tracker {
+
+struct StackedComponent {
+  xml_comp_t x_comp;
+  double center;          // along the stacking axis, relative to the module center
+  double inner_thickness; // module thickness below the component center
+  double outer_thickness; // module thickness above the component center
+};
+
+struct ModuleStack {
+  double total_thickness = 0.;
+  std::vector<StackedComponent> components;
+};
+
+// Stack the <module_component>s of a module. With position_offsets, the z of a component
+// <position> shifts the component and all the following ones (barrel module convention).
+inline ModuleStack stackComponents(xml_comp_t x_mod, bool position_offsets = false) {
+  ModuleStack stack;
+  for (xml_coll_t ci(x_mod, _U(module_component)); ci; ++ci) {
+    stack.total_thickness += xml_comp_t(ci).thickness();
+  }
+  double thickness_so_far = 0.;
+  for (xml_coll_t ci(x_mod, _U(module_component)); ci; ++ci) {
+    xml_comp_t x_comp = ci;
+    double thickness  = x_comp.thickness();
+    double offset     = 0.;
+    if (position_offsets) {
+      xml_comp_t x_pos = x_comp.position(false);
+      if (x_pos) {
+        offset = x_pos.z(0);
+      }
+    }
+    stack.components.push_back(
+        {x_comp, -stack.total_thickness / 2. + thickness_so_far + offset + thickness / 2.,
+         thickness_so_far + thickness / 2.,
+         stack.total_thickness - thickness_so_far - thickness / 2.});
+    thickness_so_far += thickness + offset;
+  }
+  return stack;
+}
+
+// module transforms in placement order, module numbers follow it
+using PlacementPlan = std::vector<dd4hep::Transform3D>;
+
+// Barrel staves: nphi staves around the beam at radius rc (alternating by dr), each a row of
+// nz modules from -z0 to z0 (alternating by z_dr in the direction of the tilted stave)
+struct StaveLayout {
+  double phi0     = 0.;
+  double phi_tilt = 0.;
+  double rc       = 0.;
+  double rphi_dr  = 0.;
+  int nphi        = 0;
+  double z0       = 0.;
+  int nz          = 0;
+  double z_dr     = 0.;
+
+  static StaveLayout fromXml(xml_comp_t x_rphi, xml_comp_t x_z) {
+    StaveLayout layout;
+    layout.phi0     = x_rphi.phi0();
+    layout.phi_tilt = x_rphi.phi_tilt();
+    layout.rc       = x_rphi.rc();
+    layout.rphi_dr  = x_rphi.dr();
+    layout.nphi     = x_rphi.nphi();
+    layout.z0       = x_z.z0();
+    layout.nz       = x_z.nz();
+    layout.z_dr     = x_z.dr();
+    return layout;
+  }
+
+  PlacementPlan plan() const {
+    PlacementPlan result;
+    result.reserve(nphi * nz);
+    double phi_incr = (M_PI * 2) / nphi;
+    double z_incr   = nz > 1 ? (2.0 * z0) / (nz - 1) : 0.0;
+    double phic     = phi0;
+    double r        = rc;
+    double dr       = rphi_dr;
+    for (int ii = 0; ii < nphi; ii++) {
+      double dx       = z_dr * std::cos(phic + phi_tilt);
+      double dy       = z_dr * std::sin(phic + phi_tilt);
+      double x        = r * std::cos(phic);
+      double y        = r * std::sin(phic);
+      double module_z = -z0;
+      for (int j = 0; j < nz; j++) {
+        result.emplace_back(dd4hep::RotationZYX(0, ((M_PI / 2) - phic - phi_tilt), -M_PI / 2),
+                            dd4hep::Position(x, y, module_z));
+        x += dx;
+        y += dy;
+        dx *= -1;
+        dy *= -1;
+        module_z += z_incr;
+      }
+      phic += phi_incr;
+      r += dr;
+      dr *= -1;
+    }
+    return result;
+  }
+
+  bool operator<(const StaveLayout& o) const {
+    return std::tie(phi0, phi_tilt, rc, rphi_dr, nphi, z0, nz, z_dr) <
+           std::tie(o.phi0, o.phi_tilt, o.rc, o.rphi_dr, o.nphi, o.z0, o.nz, o.z_dr);
+  }
+};
+
+// Endcap rings: nmodules modules at radius r from phi0 in steps of dphi, at z alternating by dz
+struct RingLayout {
+  double r     = 0.;
+  double phi0  = 0.;
+  double dphi  = 0.;
+  double z     = 0.;
+  double dz    = 0.;
+  int nmodules = 0;
+
+  PlacementPlan plan() const {
+    PlacementPlan result;
+    result.reserve(nmodules);
+    double phi = phi0;
+    double z_k = dz;
+    for (int k = 0; k < nmodules; ++k) {
+      result.emplace_back(dd4hep::RotationZYX(0, -M_PI / 2 - phi, -M_PI / 2),
+                          dd4hep::Position(-r * std::cos(phi), -r * std::sin(phi), z + z_k));
+      z_k = -z_k;
+      phi += dphi;
+    }
+    return result;
+  }
+
+  bool operator<(const RingLayout& o) const {
+    return std::tie(r, phi0, dphi, z, dz, nmodules) <
+           std::tie(o.r, o.phi0, o.dphi, o.z, o.dz, o.nmodules);
+  }
+};
+
+// Arrays: nx by ny modules centered in cells filling width by height, shifted by (x, y, z)
+struct ArrayLayout {
+  int nx        = 1;
+  int ny        = 1;
+  double width  = 0.;
+  double height = 0.;
+  double x      = 0.;
+  double y      = 0.;
+  double z      = 0.;
+
+  PlacementPlan plan() const {
+    PlacementPlan result;
+    result.reserve(nx * ny);
+    double x_delta = width / nx;
+    double y_delta = height / ny;
+    for (int ix = 0; ix < nx; ix++) {
+      for (int iy = 0; iy < ny; iy++) {
+        result.emplace_back(dd4hep::Translation3D(-width / 2.0 + x_delta / 2.0 + ix * x_delta + x,
+                                                  -height / 2.0 + y_delta / 2.0 + iy * y_delta + y,
+                                                  z));
+      }
+    }
+    return result;
+  }
+
+  bool operator<(const ArrayLayout& o) const {
+    return std::tie(nx, ny, width, height, x, y, z) <
+           std::tie(o.nx, o.ny, o.width, o.height, o.x, o.y, o.z);
+  }
+};
+
+// Placement plans of one layout policy, computed once per distinct layout
+template <typename Layout> class PlacementCache {
+public:
+  const PlacementPlan& plan(const Layout& layout) {
+    auto it = m_plans.find(layout);
+    if (it == m_plans.end()) {
+      it = m_plans.emplace(layout, layout.plan()).first;
+    }
+    return it->second;
+  }
+
+private:
+  std::map<Layout, PlacementPlan> m_plans;
+};
+
+// A module volume with its sensor placements, and their shared parameters and surfaces (if
+// the detector provides tracking surfaces)
+struct ModuleType {
+  dd4hep::Volume volume;
+  std::vector<dd4hep::PlacedVolume> sensors;
+  std::vector<DD4hepDetectorHelper::SensorDescriptor> descriptors;
+};
+
+// Add the sensor DetElements of a placed module, named prefix + sensor volume name, with the
+// module id or, with sensor_ids, the sensor number as id
+inline void addSensorElements(dd4hep::DetElement& module, const ModuleType& type,
+                              const std::string& prefix, int id, bool sensor_ids = false) {
+  for (size_t ic = 0; ic < type.sensors.size(); ++ic) {
+    dd4hep::PlacedVolume sens_pv = type.sensors[ic];
+    dd4hep::DetElement comp_de(module, prefix + sens_pv.volume().name(),
+                               sensor_ids ? int(ic + 1) : id);
+    comp_de.setPlacement(sens_pv);
+    if (ic < type.descriptors.size()) {
+      type.descriptors[ic].attach(comp_de);
+    }
+  }
+}
+
+} // namespace epic::tracker
@@ -11,6 +11,8 @@
 #include <iostream>
 #include <math.h>
 #include <tuple>
+#include "ConstructionProfiler.h"
+#include "LayeredCalorimeterBuilder.h"
 //////////////////////////////////////////////////
 // Far Forward Ion Zero Degree Calorimeter - Ecal
 // Reference from ATHENA ScFiCalorimeter_geo.cpp
@@ -41,7 +43,12 @@ static Ref_t create_detector(Detector& desc, xml_h handle, SensitiveDetector sen
   int layerid   = 0;
   double zpos_0 = -length / 2.;
 
-  for (xml_coll_t li(detElem, _Unicode(layer)); li; ++li) {
+  // the slices are placed directly in the envelope, with volume IDs named after them, so only
+  // the material budget comes from the layered calorimeter core
+  epic::calorimeter::BudgetSummary budgets;
+  int layer_type = 0;
+
+  for (xml_coll_t li(detElem, _Unicode(layer)); li; ++li, ++layer_type) {
 
     xml_comp_t x_lyr = li;
     auto nlyr        = x_lyr.attr<int>(_Unicode(nlayer));
@@ -50,6 +57,9 @@ static Ref_t create_detector(Detector& desc, xml_h handle, SensitiveDetector sen
     map<int, string> v_sl_name;
     map<string, Volume> slices;
     map<string, double> sl_thickness;
+    epic::calorimeter::LayerBudget budget;
+    budget.name   = _toString(layer_type, "layer_type%d");
+    budget.repeat = nlyr;
 
     int nsl = 0;
     xml_coll_t ci(x_lyr, _Unicode(slice));
@@ -69,7 +79,9 @@ static Ref_t create_detector(Detector& desc, xml_h handle, SensitiveDetector sen
       v_sl_name[nsl]        = sl_name;
       slices[sl_name]       = sl_Vol;
       sl_thickness[sl_name] = sl_z;
+      budget.addSlice(sl_mat, sl_z);
     }
+    budgets.add(budget);
 
     for (int ilyr = 0; ilyr < nlyr; ilyr++) {
       layerid++;
@@ -95,7 +107,8 @@ static Ref_t create_detector(Detector& desc, xml_h handle, SensitiveDetector sen
   PlacedVolume envPV = motherVol.placeVolume(env, tr);
   envPV.addPhysVolID("system", detID);
   det.setPlacement(envPV);
+  budgets.report(det, "ZDC_ImagingCal");
   return det;
 }
 
-DECLARE_DETELEMENT(ZDC_ImagingCal, create_detector)
+DECLARE_PROFILED_DETELEMENT(ZDC_ImagingCal, create_detector)
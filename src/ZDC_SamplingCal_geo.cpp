@@ -11,6 +11,7 @@
 #include <iostream>
 #include <math.h>
 #include <tuple>
+#include "ConstructionProfiler.h"
 //////////////////////////////////////////////////
 // Far Forward Ion Zero Degree Calorimeter - Ecal
 // Reference from ATHENA ScFiCalorimeter_geo.cpp
@@ -98,4 +99,4 @@ static Ref_t create_detector(Detector& desc, xml_h handle, SensitiveDetector sen
   return det;
 }
 
-DECLARE_DETELEMENT(ZDC_SamplingCal, create_detector)
+DECLARE_PROFILED_DETELEMENT(ZDC_SamplingCal, create_detector)
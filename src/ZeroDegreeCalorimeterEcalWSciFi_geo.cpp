@@ -11,6 +11,7 @@
 #include <iostream>
 #include <math.h>
 #include <tuple>
+#include "ConstructionProfiler.h"
 //////////////////////////////////////////////////
 // Far Forward Ion Zero Degree Calorimeter - Ecal
 // Reference from ATHENA ScFiCalorimeter_geo.cpp
@@ -135,4 +136,4 @@ static Ref_t create_detector(Detector& desc, xml_h handle, SensitiveDetector sen
   return det;
 }
 
-DECLARE_DETELEMENT(ZDCEcalScFiCalorimeter, create_detector)
+DECLARE_PROFILED_DETELEMENT(ZDCEcalScFiCalorimeter, create_detector)
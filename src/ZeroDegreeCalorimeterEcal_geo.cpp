@@ -7,6 +7,7 @@
 #include "DDRec/DetectorData.h"
 #include "DDRec/Surface.h"
 #include <XML/Helper.h>
+#include "ConstructionProfiler.h"
 //////////////////////////////////////////////////
 // Far Forward Ion Zero Degree Calorimeter - Ecal
 //////////////////////////////////////////////////
@@ -87,4 +88,4 @@ static Ref_t createDetector(Detector& desc, xml_h e, SensitiveDetector sens) {
   det.setPlacement(detPV);
   return det;
 }
-DECLARE_DETELEMENT(ZDC_ECAL, createDetector)
+DECLARE_PROFILED_DETELEMENT(ZDC_ECAL, createDetector)
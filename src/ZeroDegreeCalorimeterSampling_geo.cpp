@@ -8,6 +8,7 @@
 #include "DDRec/Surface.h"
 #include <XML/Helper.h>
 #include <XML/Layering.h>
+#include "ConstructionProfiler.h"
 //////////////////////////////////////////////////
 // Far Forward Ion Zero Degree Calorimeter - Hcal
 //////////////////////////////////////////////////
@@ -98,4 +99,4 @@ static Ref_t createDetector(Detector& desc, xml_h e, SensitiveDetector sens) {
 
   return det;
 }
-DECLARE_DETELEMENT(ZDC_Sampling, createDetector)
+DECLARE_PROFILED_DETELEMENT(ZDC_Sampling, createDetector)
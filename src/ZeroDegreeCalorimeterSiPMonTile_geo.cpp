@@ -8,8 +8,11 @@
 //==========================================================================
 
 #include "DD4hep/DetFactoryHelper.h"
+#include "DD4hep/Printout.h"
 #include <XML/Helper.h>
 #include <XML/Layering.h>
+#include "ConstructionProfiler.h"
+#include "LayeredCalorimeterBuilder.h"
 
 using namespace dd4hep;
 
@@ -28,6 +31,11 @@ static Ref_t createDetector(Detector& desc, xml_h handle, SensitiveDetector sens
 
   Material air = desc.material("Air");
 
+  // full: one volume per slice; homogenized: the slices of each layer are built as one volume of
+  // their mixture, with the slice ID of the sensitive slice
+  bool homogenized =
+      epic::calorimeter::homogenizedMode(detElem, "ZeroDegreeCalorimeterSiPMonTile");
+
   // Defining envelope
   Box envelope(width / 2.0, height / 2.0, length / 2.0);
 
@@ -36,11 +44,10 @@ static Ref_t createDetector(Detector& desc, xml_h handle, SensitiveDetector sens
   // Setting envelope attributes
   envelopeVol.setAttributes(desc, detElem.regionStr(), detElem.limitsStr(), detElem.visStr());
 
-  PlacedVolume pv;
-
   double z_distance_traversed = 0.;
 
   int layer_num = 1;
+  epic::calorimeter::BudgetSummary budgets;
 
   // Looping through all the different layer sections
   for (xml_coll_t c(detElem, _U(layer)); c; ++c) {
@@ -48,65 +55,40 @@ static Ref_t createDetector(Detector& desc, xml_h handle, SensitiveDetector sens
     int repeat             = x_layer.repeat();
     double layer_thickness = x_layer.thickness();
 
-    // Looping through the number of repeated layers in each section
-    for (int i = 0; i < repeat; i++) {
-      std::string layer_name = detName + _toString(layer_num, "_layer%d");
-
-      Box layer(width / 2., height / 2., layer_thickness / 2.);
-
-      Volume layer_vol(layer_name, layer, air);
-
-      int slice_num  = 1;
-      double slice_z = -layer_thickness / 2.; // Keeps track of slices' z locations in each layer
-
-      // Looping over each layer's slices
-      for (xml_coll_t l(x_layer, _U(slice)); l; ++l) {
-        xml_comp_t x_slice     = l;
-        double slice_thickness = x_slice.thickness();
-        std::string slice_name = layer_name + _toString(slice_num, "slice%d");
-        Material slice_mat     = desc.material(x_slice.materialStr());
-        slice_z += slice_thickness / 2.; // Going to slice halfway point
-
-        Box slice(width / 2., height / 2., slice_thickness / 2.);
-
-        Volume slice_vol(slice_name, slice, slice_mat);
-
-        // Setting appropriate slices as sensitive
-        if (x_slice.isSensitive()) {
-          sens.setType("calorimeter");
-          slice_vol.setSensitiveDetector(sens);
-        }
-
-        // Setting slice attributes
-        slice_vol.setAttributes(desc, x_slice.regionStr(), x_slice.limitsStr(), x_slice.visStr());
-
-        // Placing slice within layer
-        pv = layer_vol.placeVolume(slice_vol,
-                                   Transform3D(RotationZYX(0, 0, 0), Position(0., 0., slice_z)));
-        pv.addPhysVolID("slice", slice_num);
-        slice_z += slice_thickness / 2.;
-        z_distance_traversed += slice_thickness;
-        ++slice_num;
-      }
-
-      // Setting layer attributes
-      layer_vol.setAttributes(desc, x_layer.regionStr(), x_layer.limitsStr(), x_layer.visStr());
-      // Placing each layer inside the envelope volume
-      // -length/2. is front of detector in global coordinate system
-      // + (z_distance_traversed - layer_thickness) goes to the front of each layer
-      // + layer_thickness/2. places layer in correct spot
-      // Example: After placement of slices in first layer, z_distance_traversed = layer_thickness
-      //          Subtracting layer_thickness goes back to the front of the first slice (Now, z = -length/2)
-      //          Adding layer_thickness/2. goes to half the first layer thickness (proper place to put layer)
-      //          Each loop over repeat will increases z_distance_traversed by layer_thickness
-      pv = envelopeVol.placeVolume(
-          layer_vol, Transform3D(RotationZYX(0, 0, 0),
-                                 Position(0., 0.,
-                                          -length / 2. + (z_distance_traversed - layer_thickness) +
-                                              layer_thickness / 2.)));
-      pv.addPhysVolID("layer", layer_num);
-      layer_num++;
+    // The repeated layers of a section are identical: build the layer once, named after the
+    // first layer of the section
+    std::string layer_name = detName + _toString(layer_num, "_layer%d");
+    epic::calorimeter::LayerType section;
+    section.volume = Volume(layer_name, Box(width / 2., height / 2., layer_thickness / 2.), air);
+    auto slice_shape = [&](double slice_thickness) -> Solid {
+      return Box(width / 2., height / 2., slice_thickness / 2.);
+    };
+    if (homogenized) {
+      epic::calorimeter::buildHomogenizedSlices(desc, section, x_layer, layer_thickness, sens,
+                                                layer_name, slice_shape);
+    } else {
+      epic::calorimeter::buildSlices(desc, section, x_layer, layer_thickness, sens, layer_name,
+                                     slice_shape);
     }
+
+    // Setting layer attributes
+    section.volume.setAttributes(desc, x_layer.regionStr(), x_layer.limitsStr(), x_layer.visStr());
+    section.budget.name   = layer_name;
+    section.budget.repeat = repeat;
+    budgets.add(section.budget);
+
+    // Placing each layer inside the envelope volume
+    // -length/2. is front of detector in global coordinate system
+    // + z_distance_traversed goes to the front of the first layer of the section
+    // + (slices thickness - layer_thickness) + layer_thickness/2. places layer in correct spot
+    // Each repeat moves by the total thickness of the slices
+    double slices_thickness = section.budget.thickness;
+    epic::calorimeter::placeLayers(envelopeVol, section, repeat,
+                                   -length / 2. + z_distance_traversed + slices_thickness -
+                                       layer_thickness / 2.,
+                                   slices_thickness, layer_num);
+    layer_num += repeat;
+    z_distance_traversed += repeat * slices_thickness;
   }
 
   DetElement det(detName, detID);
@@ -118,7 +100,11 @@ static Ref_t createDetector(Detector& desc, xml_h handle, SensitiveDetector sens
   PlacedVolume phv = motherVol.placeVolume(envelopeVol, tr);
   phv.addPhysVolID("system", detID);
   det.setPlacement(phv);
+  budgets.report(det, "ZeroDegreeCalorimeterSiPMonTile");
+  if (homogenized) {
+    budgets.addMassFractions(desc, "ZeroDegreeCalorimeterSiPMonTile");
+  }
 
   return det;
 }
-DECLARE_DETELEMENT(ZeroDegreeCalorimeterSiPMonTile, createDetector)
+DECLARE_PROFILED_DETELEMENT(ZeroDegreeCalorimeterSiPMonTile, createDetector)
@@ -5,6 +5,7 @@
 #include "DD4hep/Printout.h"
 #include "TMath.h"
 #include <XML/Helper.h>
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -597,4 +598,4 @@ static Ref_t create_detector(Detector& det, xml_h e, SensitiveDetector /* sens *
   return sdet;
 }
 
-DECLARE_DETELEMENT(forwardBeamPipeBrazil, create_detector)
+DECLARE_PROFILED_DETELEMENT(forwardBeamPipeBrazil, create_detector)
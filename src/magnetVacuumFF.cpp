@@ -4,6 +4,7 @@
 #include "DD4hep/DetFactoryHelper.h"
 #include "DD4hep/Printout.h"
 #include <XML/Helper.h>
+#include "ConstructionProfiler.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -282,4 +283,4 @@ double getRotatedZ(double z, double x, double angle) { return z * cos(angle) - x
 
 double getRotatedX(double z, double x, double angle) { return z * sin(angle) + x * cos(angle); }
 
-DECLARE_DETELEMENT(magnetElementInnerVacuum, create_detector)
+DECLARE_PROFILED_DETELEMENT(magnetElementInnerVacuum, create_detector)
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 ePIC Collaboration
+
+// Compares the detector selection of the dependency helpers (DetectorSelection.h) with the one
+// DD4hep applies to <detector> elements (Compact2Objects: strstr of ":<name>:" and ":<type>:"
+// in REQUIRED_/IGNORED_DETECTORS(_TYPES)), for lists with and without enclosing colons, names
+// that are substrings of other names, and each variable alone and combined. Detectors with a
+// known type must be selected exactly when DD4hep builds them; without a type (file
+// dependencies), REQUIRED_DETECTOR_TYPES does not deselect anything.
+
+#include "DetectorSelection.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// DD4hep's check for a <detector> element
+bool dd4hepBuilds(const std::string& name, const std::string& type) {
+  const char* req_dets   = std::getenv("REQUIRED_DETECTORS");
+  const char* req_typs   = std::getenv("REQUIRED_DETECTOR_TYPES");
+  const char* ign_dets   = std::getenv("IGNORED_DETECTORS");
+  const char* ign_typs   = std::getenv("IGNORED_DETECTOR_TYPES");
+  std::string name_match = ":" + name + ":";
+  std::string type_match = ":" + type + ":";
+  if (req_dets && !std::strstr(req_dets, name_match.c_str()))
+    return false;
+  if (req_typs && !std::strstr(req_typs, type_match.c_str()))
+    return false;
+  if (ign_dets && std::strstr(ign_dets, name_match.c_str()))
+    return false;
+  if (ign_typs && std::strstr(ign_typs, type_match.c_str()))
+    return false;
+  return true;
+}
+
+void setList(const char* var, const char* list) {
+  if (list == nullptr) {
+    unsetenv(var);
+  } else {
+    setenv(var, list, 1);
+  }
+}
+
+} // namespace
+
+int main() {
+  const std::vector<std::pair<std::string, std::string>> detectors = {
+      {"DRICH", "epic_DRICH"},
+      {"RICHEndcapN", "epic_PFRICH"},
+      {"EcalBarrelScFi", "epic_EcalBarrelScFi"},
+      {"EcalBarrel", "epic_EcalBarrelInterlayers"},
+      {"HcalBarrel", "epic_HcalBarrelGDML"},
+      {"LFHCAL", "epic_LFHCAL"}};
+  const std::vector<const char*> name_lists = {nullptr,
+                                               "",
+                                               ":DRICH:",
+                                               "DRICH",
+                                               ":DRICH",
+                                               "DRICH:",
+                                               "DRICH:RICHEndcapN",
+                                               ":DRICH:RICHEndcapN:",
+                                               ":EcalBarrelScFi:",
+                                               ":EcalBarrel:",
+                                               ":Ecal:",
+                                               ":DRICH,RICHEndcapN:"};
+  const std::vector<const char*> type_lists = {
+      nullptr, "", ":epic_DRICH:", "epic_LFHCAL", ":epic_HcalBarrelGDML:epic_LFHCAL:",
+      ":epic_EcalBarrel:"};
+
+  int cases = 0, failures = 0;
+  for (const char* req_dets : name_lists) {
+    for (const char* req_typs : type_lists) {
+      for (const char* ign_dets : {(const char*)nullptr, ":EcalBarrel:", "LFHCAL"}) {
+        for (const char* ign_typs : {(const char*)nullptr, ":epic_DRICH:"}) {
+          setList("REQUIRED_DETECTORS", req_dets);
+          setList("REQUIRED_DETECTOR_TYPES", req_typs);
+          setList("IGNORED_DETECTORS", ign_dets);
+          setList("IGNORED_DETECTOR_TYPES", ign_typs);
+          for (const auto& [name, type] : detectors) {
+            ++cases;
+            // detectors: the same decision as DD4hep
+            bool expected = dd4hepBuilds(name, type);
+            if (DetectorSelection::isSelected(name, type) != expected) {
+              std::printf("%s (%s): selected %d, DD4hep builds %d\n", name.c_str(), type.c_str(),
+                          int(!expected), int(expected));
+              ++failures;
+            }
+            // dependencies without a type: kept whenever DD4hep builds the detector, and
+            // otherwise only for a type selection that cannot be checked without the type
+            bool dependency = DetectorSelection::isSelected(name);
+            setList("REQUIRED_DETECTOR_TYPES", nullptr);
+            setList("IGNORED_DETECTOR_TYPES", nullptr);
+            bool expected_dependency = dd4hepBuilds(name, type);
+            setList("REQUIRED_DETECTOR_TYPES", req_typs);
+            setList("IGNORED_DETECTOR_TYPES", ign_typs);
+            if (dependency != expected_dependency) {
+              std::printf("dependency of %s: selected %d, expected %d\n", name.c_str(),
+                          int(dependency), int(expected_dependency));
+              ++failures;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // fields are deselected by name only
+  setList("IGNORED_FIELDS", ":GlobalSolenoid:B0PF:");
+  for (auto [field, ignored] : {std::pair{"GlobalSolenoid", true}, std::pair{"B0PF", true},
+                                std::pair{"B0", false}, std::pair{"Solenoid", false}}) {
+    ++cases;
+    if (DetectorSelection::isFieldIgnored(field) != ignored) {
+      std::printf("field %s: ignored %d, expected %d\n", field, int(!ignored), int(ignored));
+      ++failures;
+    }
+  }
+
+  std::printf("%d cases, %d mismatches\n", cases, failures);
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 ePIC Collaboration
+
+// Compares the one-pass box classification (boxesTotalInsidePolygons) with the per-box
+// isBoxTotalInsidePolygon checks it replaced in the 12-sided disk of HomogeneousCalorimeter:
+// single points on and next to the vertices and edges of the 12-gon and the beampipe cutout,
+// and the (row, column) IDs of the modules placed by the old and the new builder loops, for the
+// backward PbWO4 ECal of backward_PbWO4.xml and sweeps of module sizes and cutouts.
+
+#include "GeometryHelpers.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+using epic::geo::Point;
+
+namespace {
+
+// 12-gon of HomogeneousCalorimeter, with the circumradius rmax / cos(protate)
+std::vector<Point> outerPolygon(double rmax, double prot) {
+  std::vector<Point> vertices;
+  for (auto [x, y] : epic::geo::getPolygonVertices({0., 0.}, rmax / std::cos(prot), M_PI / 12., 12))
+    vertices.emplace_back(x, y);
+  return vertices;
+}
+
+// beampipe cutout of backward_PbWO4.xml (cm), scaled and shifted
+std::vector<Point> cutoutPolygon(double scale, double dx, double dy) {
+  const double xy[12][2] = {{6.15, 6.15},   {6.15, 4.1},   {8.2, 4.1},     {8.2, -4.1},
+                            {6.15, -4.1},   {6.15, -6.15}, {-6.15, -6.15}, {-6.15, -4.1},
+                            {-8.2, -4.1},   {-8.2, 4.1},   {-6.15, 4.1},   {-6.15, 6.15}};
+  std::vector<Point> vertices;
+  for (const auto& p : xy)
+    vertices.emplace_back(scale * p[0] + dx, scale * p[1] + dy);
+  return vertices;
+}
+
+// (row, column) of the modules placed by the loops of the original builder
+std::vector<std::pair<int, int>> oldModules(const std::vector<Point>& points, double mod,
+                                            const std::vector<Point>& out_vertices,
+                                            const std::vector<Point>& in_vertices) {
+  const double half = mod / 2.;
+  double minX = 0., maxX = 0., minY = 0., maxY = 0.;
+  for (auto& square : points) {
+    Point box[4] = {{square.x() + half, square.y() + half},
+                    {square.x() - half, square.y() + half},
+                    {square.x() - half, square.y() - half},
+                    {square.x() + half, square.y() - half}};
+    if (epic::geo::isBoxTotalInsidePolygon(box, out_vertices)) {
+      if (square.x() < minX)
+        minX = square.x();
+      if (square.y() < minY)
+        minY = square.x();
+      if (square.x() > maxX)
+        maxX = square.x();
+      if (square.y() > maxY)
+        maxY = square.x();
+    }
+  }
+  std::vector<std::pair<int, int>> modules;
+  for (auto& square : points) {
+    Point box[4] = {{square.x() + half, square.y() + half},
+                    {square.x() - half, square.y() + half},
+                    {square.x() - half, square.y() - half},
+                    {square.x() + half, square.y() - half}};
+    if (epic::geo::isBoxTotalInsidePolygon(box, out_vertices) &&
+        !epic::geo::isBoxTotalInsidePolygon(box, in_vertices)) {
+      modules.emplace_back(std::round((maxY - square.y()) / mod),
+                           std::round((square.x() - minX) / mod));
+    }
+  }
+  return modules;
+}
+
+// (row, column) of the modules placed by the loops of the current builder
+std::vector<std::pair<int, int>> newModules(const std::vector<Point>& points, double mod,
+                                            const std::vector<Point>& out_vertices,
+                                            const std::vector<Point>& in_vertices) {
+  auto inside = epic::geo::boxesTotalInsidePolygons(points, mod / 2., mod / 2.,
+                                                    {out_vertices, in_vertices});
+  std::vector<Point> placed;
+  double minX = 0., maxX = 0., minY = 0., maxY = 0.;
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (!(inside[i] & 1u)) {
+      continue;
+    }
+    auto& square = points[i];
+    if (square.x() < minX)
+      minX = square.x();
+    if (square.y() < minY)
+      minY = square.x();
+    if (square.x() > maxX)
+      maxX = square.x();
+    if (square.y() > maxY)
+      maxY = square.x();
+    if (!(inside[i] & 2u)) {
+      placed.push_back(square);
+    }
+  }
+  std::vector<std::pair<int, int>> modules;
+  for (auto& square : placed) {
+    modules.emplace_back(std::round((maxY - square.y()) / mod),
+                         std::round((square.x() - minX) / mod));
+  }
+  return modules;
+}
+
+// points on the vertices and edges of a polygon, and next to them on either side
+std::vector<Point> boundaryPoints(const std::vector<Point>& vertices) {
+  std::vector<Point> points;
+  const size_t n = vertices.size();
+  for (size_t i = 0; i < n; ++i) {
+    const Point& a = vertices[i];
+    const Point& b = vertices[(i + 1) % n];
+    for (double t : {0., 0.25, 0.5, 1. / 3.}) {
+      const double x = a.x() + t * (b.x() - a.x()), y = a.y() + t * (b.y() - a.y());
+      for (double d : {0., 1e-7, -1e-7, 1e-5, -1e-5}) {
+        points.emplace_back(x + d, y);
+        points.emplace_back(x, y + d);
+        points.emplace_back(x + d, y + d);
+      }
+    }
+  }
+  return points;
+}
+
+} // namespace
+
+int main() {
+  int cases = 0, failures = 0;
+  long boxes_total = 0, modules_total = 0;
+
+  // single points: a box of size zero is totally inside where its point is inside
+  for (const auto& polygon : {outerPolygon(64.1, 15. * M_PI / 180.), cutoutPolygon(1., 0., 0.)}) {
+    auto points = boundaryPoints(polygon);
+    auto masks  = epic::geo::boxesTotalInsidePolygons(points, 0., 0., {polygon});
+    ++cases;
+    boxes_total += points.size();
+    for (size_t k = 0; k < points.size(); ++k) {
+      if (bool(masks[k] & 1u) != epic::geo::isPointInsidePolygon(points[k], polygon)) {
+        std::printf("point (%.8g, %.8g): inside %d, expected %d\n", points[k].x(), points[k].y(),
+                    int(masks[k] & 1u), int(epic::geo::isPointInsidePolygon(points[k], polygon)));
+        ++failures;
+      }
+    }
+  }
+
+  // module placement; 2.05 cm is the module of backward_PbWO4.xml, whose cutout vertices lie on
+  // its grid, so that module corners fall on the cutout vertices and edges
+  for (double mod : {2.05, 2.5, 4.1}) {
+    for (double rmax : {64.1, 40.}) {
+      for (double prot : {15. * M_PI / 180., 0.}) {
+        for (auto [scale, shift] : {std::pair{1., 0.}, std::pair{1., 1.025}, std::pair{1.5, 0.}}) {
+          const double half = mod / 2.;
+          auto out_vertices = outerPolygon(rmax, prot);
+          auto in_vertices  = cutoutPolygon(scale, shift, -shift);
+          auto points = epic::geo::fillRectangles({half, half}, mod, mod, 0.,
+                                                  rmax / std::cos(prot), 0., 2. * M_PI);
+          ++cases;
+          boxes_total += points.size();
+
+          // classification of every box against both polygons
+          auto masks = epic::geo::boxesTotalInsidePolygons(points, half, half,
+                                                           {out_vertices, in_vertices});
+          for (size_t i = 0; i < points.size(); ++i) {
+            const auto& c = points[i];
+            Point box[4]  = {{c.x() + half, c.y() + half},
+                             {c.x() - half, c.y() + half},
+                             {c.x() - half, c.y() - half},
+                             {c.x() + half, c.y() - half}};
+            unsigned int expected = 0u;
+            expected |= epic::geo::isBoxTotalInsidePolygon(box, out_vertices) ? 1u : 0u;
+            expected |= epic::geo::isBoxTotalInsidePolygon(box, in_vertices) ? 2u : 0u;
+            if (masks[i] != expected) {
+              std::printf("module %g rmax %g protate %g cutout %g/%g: box (%g, %g) mask %u, "
+                          "expected %u\n",
+                          mod, rmax, prot, scale, shift, c.x(), c.y(), masks[i], expected);
+              ++failures;
+            }
+          }
+
+          // (row, column) IDs, with their multiplicity
+          auto old_ids = oldModules(points, mod, out_vertices, in_vertices);
+          auto new_ids = newModules(points, mod, out_vertices, in_vertices);
+          std::sort(old_ids.begin(), old_ids.end());
+          std::sort(new_ids.begin(), new_ids.end());
+          modules_total += new_ids.size();
+          if (old_ids != new_ids) {
+            std::printf("module %g rmax %g protate %g cutout %g/%g: %zu modules, expected %zu, "
+                        "or different (row, column)\n",
+                        mod, rmax, prot, scale, shift, new_ids.size(), old_ids.size());
+            ++failures;
+          }
+        }
+      }
+    }
+  }
+  std::printf("%d cases, %ld boxes, %ld modules, %d mismatches\n", cases, boxes_total,
+              modules_total, failures);
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 ePIC Collaboration
+
+// Compares the binned fiber-to-grid assignment of the barrel ScFi calorimeter with the per-grid
+// TGeoPolygon scan it replaced: every fiber must go to the first grid (in grid order) whose
+// polygon contains it, over a sweep of slice shapes, grid sizes and lattice parities.
+
+#include "ScFiGrids.h"
+
+#include <TGeoPolygon.h>
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace epic::scfi;
+
+namespace {
+
+// assignment of the original builder: scan the grids in order, with a TGeoPolygon per grid
+std::vector<int> scanGrids(const std::vector<FiberGrid>& grids, const std::vector<Point>& fibers) {
+  std::vector<int> result(fibers.size(), -1);
+  for (size_t ig = 0; ig < grids.size(); ++ig) {
+    const auto& gr = grids[ig];
+    std::vector<double> vx, vy;
+    for (const auto& p : gr.points) {
+      vx.push_back(p.x());
+      vy.push_back(p.y());
+    }
+    TGeoPolygon poly(gr.points.size());
+    poly.SetXY(vx.data(), vy.data());
+    poly.FinishPolygon();
+    for (size_t k = 0; k < fibers.size(); ++k) {
+      double f_xy[2] = {fibers[k].x(), fibers[k].y()};
+      if (result[k] < 0 && poly.Contains(f_xy)) {
+        result[k] = ig;
+      }
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+int main() {
+  // fiber lattice of the barrel ScFi (cm)
+  const double radius = 0.05, spacing_x = 0.134, spacing_z = 0.122;
+  int cases = 0, failures = 0;
+  long fibers_total = 0;
+  for (int sides : {48, 64, 128}) {
+    const double hphi = M_PI / sides;
+    for (double rmin : {100., 104., 120.}) {
+      for (double thickness : {17 * spacing_z, 2.}) {
+        for (double grid_dr : {2., 0.5}) {
+          for (int grid_n_phi : {5, 3}) {
+            for (bool shift : {true, false}) {
+              const double trd_x1 = rmin * std::tan(hphi);
+              auto grids  = gridPoints(grid_n_phi, grid_dr, trd_x1, thickness, hphi);
+              auto fibers = fiberPositions(radius, spacing_x, spacing_z, trd_x1, thickness, hphi,
+                                           shift);
+              auto binned = assignGrids(grids, fibers, grid_n_phi, trd_x1, thickness, hphi);
+              auto golden = scanGrids(grids, fibers);
+              ++cases;
+              fibers_total += fibers.size();
+              for (size_t k = 0; k < fibers.size(); ++k) {
+                if (binned[k] != golden[k]) {
+                  std::printf("sides %d rmin %g thickness %g grid_dr %g grid_n_phi %d shift %d: "
+                              "fiber (%g, %g) in grid %d, expected %d\n",
+                              sides, rmin, thickness, grid_dr, grid_n_phi, shift,
+                              fibers[k].x(), fibers[k].y(), binned[k], golden[k]);
+                  ++failures;
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  std::printf("%d cases, %ld fibers, %d mismatches\n", cases, fibers_total, failures);
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,363 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 ePIC Collaboration
+
+// Compares the shared tracker module builder (TrackerModuleBuilder.h) with the inline loops of
+// the builders it replaced: the component stacking of the barrel modules (with <position z>
+// offsets) and of the endcap modules, the staves of BarrelTrackerWithFrame, the (reflected)
+// rings of TrapEndcapTracker with alternating dz, the rings of B0Tracker with explicit dphi,
+// the module arrays of ForwardRomanPot, and the plans handed out by PlacementCache.
+
+#include "TrackerModuleBuilder.h"
+
+#include "XML/DocumentHandler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using dd4hep::Position;
+using dd4hep::RotationZYX;
+using dd4hep::Transform3D;
+using epic::tracker::PlacementPlan;
+
+namespace {
+
+int failures = 0;
+int cases    = 0;
+long checked = 0;
+
+bool near(double a, double b) { return std::abs(a - b) <= 1e-9 * std::max(1., std::abs(b)); }
+
+void compare(const std::string& what, const PlacementPlan& plan, const PlacementPlan& expected) {
+  ++cases;
+  if (plan.size() != expected.size()) {
+    std::printf("%s: %zu placements, expected %zu\n", what.c_str(), plan.size(), expected.size());
+    ++failures;
+    return;
+  }
+  for (size_t i = 0; i < plan.size(); ++i) {
+    double a[12], b[12];
+    plan[i].GetComponents(a);
+    expected[i].GetComponents(b);
+    ++checked;
+    for (int k = 0; k < 12; ++k) {
+      if (!near(a[k], b[k])) {
+        std::printf("%s: placement %zu component %d is %.12g, expected %.12g\n", what.c_str(), i,
+                    k, a[k], b[k]);
+        ++failures;
+        break;
+      }
+    }
+  }
+}
+
+void compare(const std::string& what, double value, double expected) {
+  ++checked;
+  if (!near(value, expected)) {
+    std::printf("%s: %.12g, expected %.12g\n", what.c_str(), value, expected);
+    ++failures;
+  }
+}
+
+// component centers and (inner, outer) thicknesses of the original barrel module loop
+struct OldComponent {
+  double center, inner, outer;
+};
+
+std::vector<OldComponent> oldBarrelStack(xml_comp_t x_mod) {
+  double total_thickness = 0.;
+  for (xml_coll_t ci(x_mod, _U(module_component)); ci; ++ci)
+    total_thickness += xml_comp_t(ci).thickness();
+  std::vector<OldComponent> result;
+  double thickness_so_far = 0.0;
+  double thickness_sum    = -total_thickness / 2.0;
+  for (xml_coll_t mci(x_mod, _U(module_component)); mci; ++mci) {
+    xml_comp_t x_comp = mci;
+    xml_comp_t x_pos  = x_comp.position(false);
+    const double zoff = thickness_sum + x_comp.thickness() / 2.0;
+    result.push_back({x_pos ? x_pos.z(0) + zoff : zoff, thickness_so_far + x_comp.thickness() / 2.0,
+                      total_thickness - thickness_so_far - x_comp.thickness() / 2.0});
+    thickness_sum += x_comp.thickness();
+    thickness_so_far += x_comp.thickness();
+    if (x_pos) {
+      thickness_sum += x_pos.z(0);
+      thickness_so_far += x_pos.z(0);
+    }
+  }
+  return result;
+}
+
+// the same for the original endcap module loop, which ignores <position>
+std::vector<OldComponent> oldEndcapStack(xml_comp_t x_mod) {
+  double total_thickness = 0.;
+  for (xml_coll_t ci(x_mod, _U(module_component)); ci; ++ci)
+    total_thickness += xml_comp_t(ci).thickness();
+  std::vector<OldComponent> result;
+  double thickness_so_far = 0.0;
+  double posY             = -total_thickness / 2;
+  for (xml_coll_t ci(x_mod, _U(module_component)); ci; ++ci) {
+    double c_thick = xml_comp_t(ci).thickness();
+    result.push_back({posY + c_thick / 2, thickness_so_far + c_thick / 2.0,
+                      total_thickness - thickness_so_far - c_thick / 2.0});
+    posY += c_thick;
+    thickness_so_far += c_thick;
+  }
+  return result;
+}
+
+// stave loop of the original BarrelTrackerWithFrame
+PlacementPlan oldStaves(double phi0, double phi_tilt, double rc, int nphi, double rphi_dr,
+                        double z0, double nz, double z_dr) {
+  PlacementPlan result;
+  double phi_incr = (M_PI * 2) / nphi;
+  double phic     = phi0;
+  double z_incr   = nz > 1 ? (2.0 * z0) / (nz - 1) : 0.0;
+  double module_z = -z0;
+  for (int ii = 0; ii < nphi; ii++) {
+    double dx = z_dr * std::cos(phic + phi_tilt);
+    double dy = z_dr * std::sin(phic + phi_tilt);
+    double x  = rc * std::cos(phic);
+    double y  = rc * std::sin(phic);
+    for (int j = 0; j < nz; j++) {
+      result.emplace_back(RotationZYX(0, ((M_PI / 2) - phic - phi_tilt), -M_PI / 2),
+                          Position(x, y, module_z));
+      x += dx;
+      y += dy;
+      dx *= -1;
+      dy *= -1;
+      module_z += z_incr;
+    }
+    phic += phi_incr;
+    rc += rphi_dr;
+    rphi_dr *= -1;
+    module_z = -z0;
+  }
+  return result;
+}
+
+// ring loop of the original TrapEndcapTracker
+PlacementPlan oldEndcapRing(double r, double phi0, double zstart, double dz, int nmodules,
+                            bool reflect) {
+  PlacementPlan result;
+  double iphi = 2 * M_PI / nmodules;
+  double phi  = phi0;
+  for (int k = 0; k < nmodules; ++k) {
+    double x = -r * std::cos(phi);
+    double y = -r * std::sin(phi);
+    if (!reflect) {
+      result.emplace_back(RotationZYX(0, -M_PI / 2 - phi, -M_PI / 2), Position(x, y, zstart + dz));
+    } else {
+      result.emplace_back(RotationZYX(0, -M_PI / 2 - phi, -M_PI / 2),
+                          Position(x, y, -zstart - dz));
+    }
+    dz = -dz;
+    phi += iphi;
+  }
+  return result;
+}
+
+// ring loop of the original B0Tracker
+PlacementPlan oldB0Ring(double r, double phi0, double zstart, double dz, int nmodules,
+                        double dphi) {
+  PlacementPlan result;
+  double phi = phi0;
+  for (int k = 0; k < nmodules; ++k) {
+    double x = -r * std::cos(phi);
+    double y = -r * std::sin(phi);
+    result.emplace_back(RotationZYX(0, -M_PI / 2 - phi, -M_PI / 2), Position(x, y, zstart + dz));
+    dz = -dz;
+    phi += dphi;
+  }
+  return result;
+}
+
+// array loop of the original ForwardRomanPot
+PlacementPlan oldArray(int nx, int ny, double arr_width, double arr_height, double dz,
+                       const Position* x_pos) {
+  PlacementPlan result;
+  double arr_x_delta = arr_width / double(nx);
+  double arr_y_delta = arr_height / double(ny);
+  for (int ix = 0; ix < nx; ix++) {
+    for (int iy = 0; iy < ny; iy++) {
+      double z_pos = dz;
+      Position arr_pos(-arr_width / 2.0 + arr_x_delta / 2.0 + ix * arr_x_delta,
+                       -arr_height / 2.0 + arr_y_delta / 2.0 + iy * arr_y_delta, z_pos);
+      if (x_pos) {
+        arr_pos += *x_pos;
+      }
+      result.emplace_back(dd4hep::Translation3D(arr_pos.x(), arr_pos.y(), arr_pos.z()));
+    }
+  }
+  return result;
+}
+
+// modules as in the compact files: a barrel module with a <position z> offset on the sensor
+// and on the first component, and an endcap module with a <position> that must be ignored
+const char* modules_xml = R"(<modules>
+  <module name="BarrelModule">
+    <module_component material="Kapton" thickness="0.05*mm"/>
+    <module_component material="Silicon" thickness="0.04*mm" sensitive="true">
+      <position z="0.01*mm"/>
+    </module_component>
+    <module_component material="CarbonFiber" thickness="0.2*mm"/>
+    <module_component material="Silicon" thickness="0.3*mm" sensitive="true"/>
+  </module>
+  <module name="OffsetFirst">
+    <module_component material="Kapton" thickness="1.5*mm">
+      <position x="1*mm" z="-0.25*mm"/>
+    </module_component>
+    <module_component material="Silicon" thickness="0.3*mm" sensitive="true">
+      <position z="2*mm"/>
+    </module_component>
+    <module_component material="Kapton" thickness="0.7*mm"/>
+  </module>
+  <module name="EndcapModule">
+    <module_component material="CarbonFiber" thickness="0.5*mm"/>
+    <module_component material="Silicon" thickness="0.3*mm" sensitive="true">
+      <position z="1*mm"/>
+    </module_component>
+    <module_component material="Kapton" thickness="0.1*mm"/>
+  </module>
+</modules>)";
+
+} // namespace
+
+int main() {
+  dd4hep::xml::DocumentHolder doc(
+      dd4hep::xml::DocumentHandler().parse(modules_xml, std::strlen(modules_xml)));
+  xml_h x_modules = doc.root();
+
+  // component stacking
+  for (xml_coll_t mi(x_modules, _U(module)); mi; ++mi) {
+    xml_comp_t x_mod       = mi;
+    const std::string name = x_mod.nameStr();
+    for (bool position_offsets : {true, false}) {
+      auto stack             = epic::tracker::stackComponents(x_mod, position_offsets);
+      auto expected          = position_offsets ? oldBarrelStack(x_mod) : oldEndcapStack(x_mod);
+      const std::string what = name + (position_offsets ? " (barrel)" : " (endcap)");
+      ++cases;
+      if (stack.components.size() != expected.size()) {
+        std::printf("%s: %zu components, expected %zu\n", what.c_str(), stack.components.size(),
+                    expected.size());
+        ++failures;
+        continue;
+      }
+      for (size_t i = 0; i < expected.size(); ++i) {
+        const std::string c = what + " component " + std::to_string(i);
+        compare(c + " center", stack.components[i].center, expected[i].center);
+        compare(c + " inner thickness", stack.components[i].inner_thickness, expected[i].inner);
+        compare(c + " outer thickness", stack.components[i].outer_thickness, expected[i].outer);
+      }
+    }
+  }
+
+  // barrel staves, with and without alternating radii and z displacements
+  for (int nphi : {1, 12, 37}) {
+    for (int nz : {1, 2, 7}) {
+      for (double rphi_dr : {0., 0.3}) {
+        for (double z_dr : {0., 0.15}) {
+          epic::tracker::StaveLayout layout;
+          layout.phi0     = 0.1;
+          layout.phi_tilt = 0.2;
+          layout.rc       = 27.;
+          layout.rphi_dr  = rphi_dr;
+          layout.nphi     = nphi;
+          layout.z0       = 38.5;
+          layout.nz       = nz;
+          layout.z_dr     = z_dr;
+          compare("stave nphi " + std::to_string(nphi) + " nz " + std::to_string(nz) + " dr " +
+                      std::to_string(rphi_dr) + " z_dr " + std::to_string(z_dr),
+                  layout.plan(), oldStaves(0.1, 0.2, 27., nphi, rphi_dr, 38.5, nz, z_dr));
+        }
+      }
+    }
+  }
+
+  // endcap rings, reflected as in TrapEndcapTracker_geo.cpp, with alternating dz
+  for (bool reflect : {false, true}) {
+    for (int nmodules : {1, 16, 21}) {
+      for (double dz : {0., 0.4, -0.4}) {
+        double z_sign = reflect ? -1.0 : 1.0;
+        epic::tracker::RingLayout layout;
+        layout.r        = 12.5;
+        layout.phi0     = 0.05;
+        layout.nmodules = nmodules;
+        layout.dphi     = 2 * M_PI / layout.nmodules;
+        layout.z        = z_sign * 25.;
+        layout.dz       = z_sign * dz;
+        compare(std::string(reflect ? "reflected " : "") + "endcap ring n " +
+                    std::to_string(nmodules) + " dz " + std::to_string(dz),
+                layout.plan(), oldEndcapRing(12.5, 0.05, 25., dz, nmodules, reflect));
+      }
+    }
+  }
+
+  // B0 rings, with the full ring or an explicit dphi
+  for (int nmodules : {4, 9}) {
+    for (double dphi : {2 * M_PI / nmodules, M_PI / 2, -0.3}) {
+      epic::tracker::RingLayout layout;
+      layout.r        = 4.;
+      layout.phi0     = M_PI / 4;
+      layout.nmodules = nmodules;
+      layout.z        = 590.;
+      layout.dz       = 0.25;
+      layout.dphi     = dphi;
+      compare("B0 ring n " + std::to_string(nmodules) + " dphi " + std::to_string(dphi),
+              layout.plan(), oldB0Ring(4., M_PI / 4, 590., 0.25, nmodules, dphi));
+    }
+  }
+
+  // Roman pot arrays, with and without <position>
+  const Position shift(1.5, -0.5, 0.2);
+  for (int nx : {1, 3}) {
+    for (int ny : {1, 4}) {
+      for (const Position* x_pos : {(const Position*)nullptr, &shift}) {
+        epic::tracker::ArrayLayout layout;
+        layout.nx     = nx;
+        layout.ny     = ny;
+        layout.z      = 0.1;
+        layout.width  = 3.2;
+        layout.height = 2.4;
+        if (x_pos) {
+          layout.x = x_pos->x();
+          layout.y = x_pos->y();
+          layout.z += x_pos->z();
+        }
+        compare("array " + std::to_string(nx) + "x" + std::to_string(ny) +
+                    (x_pos ? " with position" : ""),
+                layout.plan(), oldArray(nx, ny, 3.2, 2.4, 0.1, x_pos));
+      }
+    }
+  }
+
+  // the cache computes each distinct plan once and hands out the same plan for equal layouts
+  {
+    epic::tracker::PlacementCache<epic::tracker::RingLayout> cache;
+    epic::tracker::RingLayout a;
+    a.r        = 12.5;
+    a.nmodules = 16;
+    a.dphi     = 2 * M_PI / a.nmodules;
+    a.z        = 25.;
+    a.dz       = 0.4;
+    epic::tracker::RingLayout b      = a;
+    b.dz                             = -0.4;
+    epic::tracker::RingLayout a_copy = a;
+
+    const PlacementPlan& plan_a = cache.plan(a);
+    const PlacementPlan& plan_b = cache.plan(b);
+    ++cases;
+    if (&cache.plan(a_copy) != &plan_a || &cache.plan(b) != &plan_b || &plan_a == &plan_b) {
+      std::printf("PlacementCache: equal layouts do not share one plan, or distinct ones do\n");
+      ++failures;
+    }
+    compare("cached ring a", plan_a, oldEndcapRing(12.5, 0., 25., 0.4, 16, false));
+    compare("cached ring b", plan_b, oldEndcapRing(12.5, 0., 25., -0.4, 16, false));
+  }
+
+  std::printf("%d cases, %ld placements and components, %d mismatches\n", cases, checked,
+              failures);
+  return failures == 0 ? 0 : 1;
+}